@@ -1,6 +1,7 @@
 #include "archiver_client.hpp"
 #include "ingest_client.hpp"
 #include "h5_parser.hpp"
+#include "name_tokenizer.hpp"
 #include <iostream>
 #include <sstream>
 #include <chrono>
@@ -18,19 +19,15 @@ std::vector<SignalData> convertArchiverToSignalData(const ArchiverResponse &arch
     signal.info.full_name = pv_name;
 
     // Parse PV name into components
-    std::vector<std::string> parts;
-    std::istringstream ss(pv_name);
-    std::string part;
-    while (std::getline(ss, part, ':')) {
-        parts.push_back(part);
-    }
+    std::string_view parts[4];
+    size_t part_count = NameTokenizer::Split(pv_name, ':', parts, 4);
 
     // Set device info with defaults
-    const std::string unknown = "UNKNOWN";
-    signal.info.device = parts.size() > 0 ? parts[0] : unknown;
-    signal.info.device_area = parts.size() > 1 ? parts[1] : unknown;
-    signal.info.device_location = parts.size() > 2 ? parts[2] : unknown;
-    signal.info.device_attribute = parts.size() > 3 ? parts[3] : unknown;
+    const std::string_view unknown = "UNKNOWN";
+    signal.info.device = part_count > 0 ? parts[0] : unknown;
+    signal.info.device_area = part_count > 1 ? parts[1] : unknown;
+    signal.info.device_location = part_count > 2 ? parts[2] : unknown;
+    signal.info.device_attribute = part_count > 3 ? parts[3] : unknown;
 
     // Determine signal type
     if (!archiver_response.metadata.enums.empty()) {
@@ -0,0 +1,302 @@
+/**
+ * Benchmark for the column codecs against the dense protobuf encoding the
+ * ingestion path sends today: KLYS and BPMS signal columns (Gorilla XOR)
+ * and their epoch-nanosecond timestamps (delta-of-delta).
+ *
+ * With an H5 directory the KLYS_* and BPMS_* signals found there are used;
+ * without one a synthetic corpus of float-precision readbacks at 120 Hz
+ * stands in. Every column is round-tripped and compared bit for bit first,
+ * so sizes and timings are only reported for lossless output.
+ *
+ * Usage: ./codec_bench [h5_directory] [iterations]
+ */
+
+#include "column_encoder.hpp"
+#include "common_client.hpp"
+#include "parsers/h5_parser.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ========== Corpus ==========
+
+struct Series {
+    std::string name;
+    std::vector<double> values;
+};
+
+struct Corpus {
+    std::vector<Series> klys;
+    std::vector<Series> bpms;
+    std::vector<std::vector<uint64_t>> timestamps;  // Epoch nanoseconds, one per file
+};
+
+bool loadH5(const std::string& directory, Corpus& corpus) {
+    H5Parser parser(directory);
+    SignalSelector selector;
+    selector.include = {"KLYS_*", "BPMS_*"};
+    parser.setSignalSelector(selector);
+    if (!parser.parseDirectory()) {
+        return false;
+    }
+
+    std::set<const TimestampData*> seen;
+    for (const auto& signal : parser.getAllSignals()) {
+        Series series{signal.info.full_name, signal.toDoubleValues()};
+        (signal.info.device == "KLYS" ? corpus.klys : corpus.bpms).push_back(std::move(series));
+
+        const TimestampData* timestamps = signal.timestamps.get();
+        if (timestamps && seen.insert(timestamps).second) {
+            std::vector<uint64_t> nanos(timestamps->count);
+            for (size_t i = 0; i < timestamps->count; ++i) {
+                nanos[i] = timestamps->seconds[i] * 1000000000ULL + timestamps->nanoseconds[i];
+            }
+            corpus.timestamps.push_back(std::move(nanos));
+        }
+    }
+    return !corpus.klys.empty() || !corpus.bpms.empty();
+}
+
+// Float-precision readbacks as the archiver stores them: slow drift plus
+// noise, held for a few samples when the PV updates slower than the beam
+std::vector<double> readback(std::mt19937_64& rng, size_t count, double level, double drift,
+                             double noise, size_t hold) {
+    std::normal_distribution<double> jitter(0.0, noise);
+    std::vector<double> values(count);
+    double current = level;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % hold == 0) {
+            current = level + drift * std::sin(i * 1e-4) + jitter(rng);
+        }
+        values[i] = static_cast<float>(current);
+    }
+    return values;
+}
+
+Corpus makeCorpus(size_t signals, size_t samples) {
+    std::mt19937_64 rng(42);
+    Corpus corpus;
+    for (size_t s = 0; s < signals; ++s) {
+        std::string unit = std::to_string(21 + s);
+        corpus.klys.push_back({"KLYS_LI" + unit + "_31_AMPL", readback(rng, samples, 60.0, 0.5, 0.01, 1)});
+        corpus.klys.push_back({"KLYS_LI" + unit + "_31_PHAS", readback(rng, samples, -20.0, 2.0, 0.05, 4)});
+        corpus.bpms.push_back({"BPMS_LI" + unit + "_201_X", readback(rng, samples, 0.0, 0.1, 0.002, 1)});
+        corpus.bpms.push_back({"BPMS_LI" + unit + "_201_TMIT", readback(rng, samples, 1.6e9, 1e7, 1e6, 8)});
+    }
+
+    // 120 Hz with sub-microsecond jitter, then the same rate exactly
+    std::uniform_int_distribution<int64_t> jitter(-500, 500);
+    uint64_t start = 1700000000ULL * 1000000000ULL;
+    std::vector<uint64_t> jittered(samples), exact(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        jittered[i] = start + i * 8333333ULL + jitter(rng);
+        exact[i] = start + i * 8333333ULL;
+    }
+    corpus.timestamps.push_back(std::move(jittered));
+    corpus.timestamps.push_back(std::move(exact));
+    return corpus;
+}
+
+// ========== Protobuf Baselines ==========
+
+std::string protobufTimestamps(CommonClient& client, const std::vector<uint64_t>& nanos) {
+    std::vector<Timestamp> list;
+    list.reserve(nanos.size());
+    for (uint64_t t : nanos) {
+        list.push_back(client.CreateTimestamp(t / 1000000000ULL, t % 1000000000ULL));
+    }
+    return client.CreateTimestampList(list).SerializeAsString();
+}
+
+void decodeProtobufColumn(const std::string& bytes, std::vector<double>& values) {
+    DataColumn column;
+    column.ParseFromString(bytes);
+    values.resize(column.datavalues_size());
+    for (int i = 0; i < column.datavalues_size(); ++i) {
+        values[i] = column.datavalues(i).doublevalue();
+    }
+}
+
+void decodeProtobufTimestamps(const std::string& bytes, std::vector<uint64_t>& nanos) {
+    TimestampList list;
+    list.ParseFromString(bytes);
+    nanos.resize(list.timestamps_size());
+    for (int i = 0; i < list.timestamps_size(); ++i) {
+        const auto& t = list.timestamps(i);
+        nanos[i] = t.epochseconds() * 1000000000ULL + t.nanoseconds();
+    }
+}
+
+// ========== Timing ==========
+
+template<typename F>
+double seconds(size_t iterations, F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        body();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+struct Row {
+    size_t samples = 0;
+    size_t protobuf_bytes = 0;
+    size_t codec_bytes = 0;
+    double protobuf_encode = 0, protobuf_decode = 0;  // Seconds per pass
+    double codec_encode = 0, codec_decode = 0;
+};
+
+void report(const char* what, const Row& row) {
+    auto rate = [&](double secs) { return row.samples * 8.0 / 1e6 / secs; };
+    std::cout << std::left << std::setw(12) << what << std::right << std::fixed
+              << std::setw(10) << row.samples
+              << std::setw(13) << row.protobuf_bytes << std::setw(12) << row.codec_bytes
+              << std::setprecision(1) << std::setw(8) << (double)row.protobuf_bytes / row.codec_bytes << "x"
+              << std::setprecision(2) << std::setw(8) << 8.0 * row.codec_bytes / row.samples
+              << std::setprecision(0)
+              << std::setw(9) << rate(row.protobuf_encode) << std::setw(9) << rate(row.protobuf_decode)
+              << std::setw(9) << rate(row.codec_encode) << std::setw(9) << rate(row.codec_decode)
+              << std::endl;
+}
+
+// Lossless check, then sizes and timings for one group of value columns
+bool measureValues(CommonClient& client, const std::vector<Series>& group, size_t iterations, Row& row) {
+    std::vector<double> decoded;
+    std::vector<std::string> protobuf;
+    std::vector<DataColumn> encoded;
+    for (const auto& series : group) {
+        encoded.push_back(client.EncodeColumn(series.name, series.values));
+        if (!client.DecodeColumn(encoded.back(), decoded) || decoded.size() != series.values.size() ||
+            std::memcmp(decoded.data(), series.values.data(), decoded.size() * sizeof(double)) != 0) {
+            std::cerr << series.name << " did not round-trip" << std::endl;
+            return false;
+        }
+        protobuf.push_back(ColumnEncoder::EncodeDoubleColumn(series.name, series.values.data(), series.values.size()));
+        row.samples += series.values.size();
+        row.codec_bytes += encoded.back().ByteSizeLong();
+        row.protobuf_bytes += protobuf.back().size();
+    }
+
+    row.protobuf_encode = seconds(iterations, [&] {
+        for (const auto& series : group) {
+            protobuf.back() = ColumnEncoder::EncodeDoubleColumn(series.name, series.values.data(), series.values.size());
+        }
+    });
+    row.protobuf_decode = seconds(iterations, [&] {
+        for (const auto& bytes : protobuf) {
+            decodeProtobufColumn(bytes, decoded);
+        }
+    });
+    row.codec_encode = seconds(iterations, [&] {
+        for (const auto& series : group) {
+            encoded.back() = client.EncodeColumn(series.name, series.values);
+        }
+    });
+    row.codec_decode = seconds(iterations, [&] {
+        for (const auto& column : encoded) {
+            client.DecodeColumn(column, decoded);
+        }
+    });
+    return true;
+}
+
+bool measureTimestamps(CommonClient& client, const std::vector<std::vector<uint64_t>>& group,
+                       size_t iterations, Row& row) {
+    std::vector<uint64_t> decoded;
+    std::vector<std::string> protobuf;
+    std::vector<DataColumn> encoded;
+    for (const auto& nanos : group) {
+        encoded.push_back(client.EncodeColumn("timestamps", nanos));
+        if (!client.DecodeColumn(encoded.back(), decoded) || decoded != nanos) {
+            std::cerr << "timestamps did not round-trip" << std::endl;
+            return false;
+        }
+        protobuf.push_back(protobufTimestamps(client, nanos));
+        row.samples += nanos.size();
+        row.codec_bytes += encoded.back().ByteSizeLong();
+        row.protobuf_bytes += protobuf.back().size();
+    }
+
+    row.protobuf_encode = seconds(iterations, [&] {
+        for (const auto& nanos : group) {
+            protobuf.back() = protobufTimestamps(client, nanos);
+        }
+    });
+    row.protobuf_decode = seconds(iterations, [&] {
+        for (const auto& bytes : protobuf) {
+            decodeProtobufTimestamps(bytes, decoded);
+        }
+    });
+    row.codec_encode = seconds(iterations, [&] {
+        for (const auto& nanos : group) {
+            encoded.back() = client.EncodeColumn("timestamps", nanos);
+        }
+    });
+    row.codec_decode = seconds(iterations, [&] {
+        for (const auto& column : encoded) {
+            client.DecodeColumn(column, decoded);
+        }
+    });
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string directory;
+    int next = 1;
+    if (argc > next && !std::isdigit(static_cast<unsigned char>(argv[next][0]))) {
+        directory = argv[next++];
+    }
+    size_t iterations = argc > next ? std::max<size_t>(1, std::strtoul(argv[next], nullptr, 10)) : 5;
+
+    Corpus corpus;
+    if (!directory.empty()) {
+        if (!loadH5(directory, corpus)) {
+            std::cerr << "No KLYS_* or BPMS_* signals found in " << directory << std::endl;
+            return 1;
+        }
+        std::cout << "Corpus: " << directory << std::endl;
+    } else {
+        corpus = makeCorpus(8, 100000);
+        std::cout << "Corpus: synthetic, 8 sectors x 100000 samples" << std::endl;
+    }
+
+    CommonClient client;
+    Row klys, bpms, timestamps;
+    if (!measureValues(client, corpus.klys, iterations, klys) ||
+        !measureValues(client, corpus.bpms, iterations, bpms) ||
+        !measureTimestamps(client, corpus.timestamps, iterations, timestamps)) {
+        return 1;
+    }
+
+    std::cout << "All columns round-trip exactly; " << iterations << " iterations, MB/s of raw 8-byte samples"
+              << std::endl;
+    std::cout << std::left << std::setw(12) << "" << std::right << std::setw(10) << "samples"
+              << std::setw(13) << "protobuf B" << std::setw(12) << "codec B" << std::setw(9) << "ratio"
+              << std::setw(8) << "bits" << std::setw(9) << "pb enc" << std::setw(9) << "pb dec"
+              << std::setw(9) << "enc" << std::setw(9) << "dec" << std::endl;
+    if (klys.samples) {
+        report("KLYS", klys);
+    }
+    if (bpms.samples) {
+        report("BPMS", bpms);
+    }
+    if (timestamps.samples) {
+        report("timestamps", timestamps);
+    }
+
+    return 0;
+}
@@ -10,19 +10,44 @@
  * - Optimized I/O with prefetch and async processing
  * - Intelligent batching for network transmission
  *
- * Architecture: Multiple files processed concurrently, HDF5 operations serialized per file
- * Usage: ./h5_processor <directory> [--resume]
+ * Architecture: HDF5 reads serialized in a reader stage, request building and gRPC
+ * sends run in separate stages connected by byte-bounded queues
+ * Usage: ./h5_processor <directory> [--resume] [--bulk | --async] [--window=N] [--pack=K] [--max-frame-bytes=N]
+ *        [--max-message-bytes=N]
+ *   --bulk      send over long-lived bidi streams (one per sender) instead of unary RPCs
+ *   --async     issue unary RPCs on the client's completion queues without blocking senders
+ *   --window=N  unacknowledged requests allowed per stream (bulk) or in total (async)
+ *   --pack=K    put up to K signals of a file into one multi-column IngestionDataFrame;
+ *               per-PV attributes are kept as "<pv>.<attribute>" on the frame
+ *   --max-frame-bytes=N  encoded size cap per frame; signals that would exceed it are split
+ *                        into time-contiguous sub-buckets, each with its own clock
+ *                        (default 7/8 of the message limit, leaving room for the envelope)
+ *   --max-message-bytes=N  gRPC send/receive limit of the channels (default 4 MB, the
+ *                        service's default receive limit)
+ *   --channels=N  spread RPCs over N separate connections to the service
+ *   --least-outstanding  pick the pooled channel with the fewest unfinished calls
+ *   --double-columns  widen every signal to double instead of sending it in its stored type
+ *   --direct-chunks   fetch compressed chunks raw under the HDF5 mutex and inflate them on a
+ *                     decode pool after releasing it
+ *   --no-mmap         read contiguous datasets through HDF5 instead of zero-copy file mappings
+ *   --sparse-nan      send float/double columns that contain NaN as a validity bitmap plus
+ *                     packed values (ColumnEncoder::SPARSE_ENCODING) when that is smaller
  */
 
 #include "parsers/h5_parser.hpp"
+#include "parsers/name_tokenizer.hpp"
 #include "clients/ingest_client.hpp"
 #include "clients/common_client.hpp"
+#include "clients/column_encoder.hpp"
+#include "clients/sample_stats.hpp"
 #include <H5Cpp.h>
+#include <google/protobuf/arena.h>
 #include <iostream>
 #include <filesystem>
 #include <thread>
 #include <atomic>
 #include <queue>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
 #include <unordered_set>
@@ -36,10 +61,12 @@
 #include <iomanip>
 #include <sstream>
 #include <cstddef>
+#include <cstdlib>
 #include <utility>
 #include <functional>
 #include <future>
-#include <immintrin.h>
+#include <variant>
+#include <type_traits>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -49,9 +76,22 @@ constexpr size_t OPTIMAL_WORKER_THREADS = 8;        // Optimal for most systems
 constexpr size_t BATCH_SIZE = 64;                   // Cache-optimized batching
 constexpr size_t PROGRESS_INTERVAL = 16;            // Reduced logging overhead
 constexpr size_t IO_BUFFER_SIZE = 64 * 1024 * 1024; // 64MB optimal I/O buffer
-constexpr size_t MEMORY_POOL_SIZE = 512 * 1024 * 1024; // 512MB pools (reduced)
+constexpr size_t BUFFER_POOL_CACHED_BYTES = 512ULL * 1024 * 1024;  // Idle signal buffers kept for reuse
+constexpr size_t BUFFER_POOL_THREAD_CACHE = 2;      // Idle buffers per size class per thread
 constexpr size_t MAX_SIGNALS_PER_BATCH = 1000;      // Signal processing limit
 constexpr size_t MAX_CONCURRENT_FILES = 12;         // Prevent resource exhaustion
+constexpr size_t BUILDER_THREADS = 2;               // Request construction stage
+constexpr size_t SENDER_THREADS = 8;                // Concurrent network senders
+constexpr size_t BUILD_QUEUE_BYTES = 512ULL * 1024 * 1024;  // Raw signal data awaiting build
+constexpr size_t SEND_QUEUE_BYTES = 1024ULL * 1024 * 1024;  // Encoded requests awaiting send
+constexpr size_t DEFAULT_BULK_WINDOW = 64;          // In-flight requests per bulk stream
+constexpr size_t DEFAULT_ASYNC_WINDOW = 256;        // In-flight unary RPCs in async mode
+constexpr size_t ASYNC_POLLER_THREADS = 2;          // Completion queue threads in async mode
+constexpr size_t READ_BATCH_SIGNALS = 32;           // Signals per reader -> builder handoff
+constexpr size_t ARENA_INITIAL_BLOCK_BYTES = 256 * 1024;    // Reused arena block per request batch
+constexpr size_t FRAME_HEADROOM_DIVISOR = 8;       // Default frame cap leaves 1/8 of the message limit
+constexpr size_t FRAME_FIXED_BYTES = 256;           // Clock and column framing besides samples and name
+constexpr size_t ATTRIBUTE_FRAMING_BYTES = 6;       // Tags and lengths around one short attribute
 
 // High-performance aligned structures
 struct alignas(64) ProcessingStats {
@@ -65,6 +105,24 @@ struct alignas(64) ProcessingStats {
     ProcessingStats() : start_time(std::chrono::steady_clock::now()) {}
 };
 
+// Command line options
+struct ProcessorOptions {
+    std::string directory;
+    bool resume = false;
+    bool bulk = false;
+    bool async = false;
+    size_t window = 0;  // 0 = mode default
+    size_t pack_columns = 1;  // 1 = one frame per signal
+    size_t max_frame_bytes = 0;  // 0 = derive from max_message_bytes
+    size_t max_message_bytes = ChannelPool::DEFAULT_MAX_MESSAGE_BYTES;
+    size_t channels = 1;
+    ChannelPool::Policy channel_policy = ChannelPool::Policy::RoundRobin;
+    bool native_types = true;  // Send float32/integer signals without widening
+    bool direct_chunks = false;  // Inflate compressed chunks outside the HDF5 mutex
+    bool memory_mapping = true;  // Zero-copy views of contiguous datasets
+    bool sparse_nan = false;  // Sparse encoding for float columns with NaNs
+};
+
 // Robust metadata parsing that works with any filename format
 struct FileMetadata {
     std::string beam_line, date, time_id, filename;
@@ -108,74 +166,423 @@ struct PvInfo {
     std::string device_type, device_area, device_location, measurement_type;
     bool valid = false;
 
-    explicit PvInfo(const std::string& pv_name) {
-        if (pv_name.empty()) return;
-
-        size_t pos = 0, count = 0;
+    explicit PvInfo(std::string_view pv_name) {
+        std::string_view fields[4];
+        size_t count = NameTokenizer::Split(pv_name, '_', fields, 4);
         std::string* targets[] = {&device_type, &device_area, &device_location, &measurement_type};
-
-        while (pos < pv_name.length() && count < 4) {
-            size_t next = pv_name.find('_', pos);
-            if (next == std::string::npos) {
-                *targets[count] = pv_name.substr(pos);
-                count++;
-                break;
-            }
-            *targets[count] = pv_name.substr(pos, next - pos);
-            pos = next + 1;
-            count++;
+        for (size_t i = 0; i < count; ++i) {
+            *targets[i] = fields[i];
         }
         valid = (count >= 3); // More lenient validation
     }
 };
 
 /**
- * Production-grade memory pool optimized for HDF5 data
+ * Size-classed buffer pool for signal and timestamp arrays.
+ *
+ * Buffers are handed out uninitialized and come back to a small per-thread
+ * cache when released; overflow goes to a shared per-class free list so that
+ * buffers freed by the builders are picked up again by the readers. Sizes are
+ * rounded up to classes about 25% apart, and the pool stops retaining memory
+ * beyond max_cached_bytes, so steady-state RSS is bounded by what the pipeline
+ * queues can hold plus that cap. Recycled buffers have already been faulted
+ * in, which saves the page faults and zeroing of a fresh multi-MB vector.
  */
-class OptimizedMemoryPool {
+class SignalBufferPool {
+public:
+    struct Stats {
+        uint64_t hits = 0;          // Served from a thread cache or the shared lists
+        uint64_t misses = 0;        // Needed a fresh allocation
+        uint64_t oversize = 0;      // Larger than the biggest class, never pooled
+        size_t bytes_in_use = 0;
+        size_t bytes_cached = 0;
+        size_t peak_bytes = 0;      // Peak of in use + cached, i.e. what the pool holds
+    };
+
+    static SignalBufferPool& instance() {
+        static SignalBufferPool pool(BUFFER_POOL_CACHED_BYTES);
+        return pool;
+    }
+
+    // Returns a buffer of at least `bytes`; `capacity` receives its real size
+    void* acquire(size_t bytes, size_t& capacity) {
+        size_t cls = classFor(bytes);
+        if (cls == class_sizes_.size()) {
+            capacity = roundUp(bytes);
+            oversize_.fetch_add(1, std::memory_order_relaxed);
+            return allocateFresh(capacity);
+        }
+        capacity = class_sizes_[cls];
+
+        ThreadCache& cache = threadCache();
+        auto& local = cache.lists[cls];
+        if (!local.empty()) {
+            void* ptr = local.back();
+            local.pop_back();
+            noteReuse(capacity);
+            return ptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(shared_[cls].mutex);
+            auto& list = shared_[cls].buffers;
+            if (!list.empty()) {
+                void* ptr = list.back();
+                list.pop_back();
+                noteReuse(capacity);
+                return ptr;
+            }
+        }
+
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return allocateFresh(capacity);
+    }
+
+    void release(void* ptr, size_t capacity) {
+        if (!ptr) return;
+        bytes_in_use_.fetch_sub(capacity, std::memory_order_relaxed);
+
+        size_t cls = classFor(capacity);
+        if (cls == class_sizes_.size() || class_sizes_[cls] != capacity) {
+            std::free(ptr);
+            return;
+        }
+
+        ThreadCache& cache = threadCache();
+        auto& local = cache.lists[cls];
+        if (local.size() < BUFFER_POOL_THREAD_CACHE) {
+            local.push_back(ptr);
+            bytes_cached_.fetch_add(capacity, std::memory_order_relaxed);
+            return;
+        }
+        releaseShared(cls, ptr, capacity);
+    }
+
+    Stats stats() const {
+        Stats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.oversize = oversize_.load(std::memory_order_relaxed);
+        stats.bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+        stats.bytes_cached = bytes_cached_.load(std::memory_order_relaxed);
+        stats.peak_bytes = peak_bytes_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
 private:
-    struct alignas(64) MemoryBlock {
-        std::atomic<void*> next{nullptr};
-        size_t size;
-        char data[];
+    static constexpr size_t PAGE_BYTES = 4096;
+    static constexpr size_t MIN_CLASS_BYTES = 64 * 1024;
+    static constexpr size_t MAX_CLASS_BYTES = 256ULL * 1024 * 1024;
+
+    struct SharedList {
+        std::mutex mutex;
+        std::vector<void*> buffers;
     };
 
-    std::atomic<MemoryBlock*> free_list_{nullptr};
-    std::vector<std::unique_ptr<char[]>> chunks_;
-    std::mutex allocation_mutex_; // Simplified thread safety
+    // Per-thread free lists; handed back to the shared lists at thread exit
+    struct ThreadCache {
+        SignalBufferPool* pool;
+        std::vector<std::vector<void*>> lists;
 
-public:
-    OptimizedMemoryPool() {
-        // Pre-allocate optimized chunks for HDF5 data
-        for (int i = 0; i < 2; ++i) { // Reduced to 2 chunks
-            auto chunk = std::make_unique<char[]>(MEMORY_POOL_SIZE);
-            madvise(chunk.get(), MEMORY_POOL_SIZE, MADV_SEQUENTIAL);
-            chunks_.push_back(std::move(chunk));
+        explicit ThreadCache(SignalBufferPool* owner)
+            : pool(owner), lists(owner->class_sizes_.size()) {}
+
+        ~ThreadCache() {
+            for (size_t cls = 0; cls < lists.size(); ++cls) {
+                for (void* ptr : lists[cls]) {
+                    pool->bytes_cached_.fetch_sub(pool->class_sizes_[cls], std::memory_order_relaxed);
+                    pool->releaseShared(cls, ptr, pool->class_sizes_[cls]);
+                }
+            }
         }
+    };
+
+    std::vector<size_t> class_sizes_;
+    std::unique_ptr<SharedList[]> shared_;
+    const size_t max_cached_bytes_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> oversize_{0};
+    std::atomic<size_t> bytes_in_use_{0};
+    std::atomic<size_t> bytes_cached_{0};
+    std::atomic<size_t> peak_bytes_{0};
+
+    explicit SignalBufferPool(size_t max_cached_bytes) : max_cached_bytes_(max_cached_bytes) {
+        for (size_t size = MIN_CLASS_BYTES; size <= MAX_CLASS_BYTES; ) {
+            class_sizes_.push_back(size);
+            size = roundUp(size + size / 4);
+        }
+        shared_ = std::make_unique<SharedList[]>(class_sizes_.size());
     }
 
-    void* allocate(size_t size) {
-        // Simple thread-safe allocation for production stability
-        std::lock_guard<std::mutex> lock(allocation_mutex_);
-        void* ptr = aligned_alloc(64, size);
-        if (ptr) {
-            madvise(ptr, size, MADV_WILLNEED);
+    ~SignalBufferPool() {
+        for (size_t cls = 0; cls < class_sizes_.size(); ++cls) {
+            for (void* ptr : shared_[cls].buffers) {
+                std::free(ptr);
+            }
         }
+    }
+
+    static size_t roundUp(size_t bytes) {
+        return (std::max<size_t>(bytes, 1) + PAGE_BYTES - 1) / PAGE_BYTES * PAGE_BYTES;
+    }
+
+    // Index of the smallest class that fits, or class_sizes_.size() if none does
+    size_t classFor(size_t bytes) const {
+        return std::lower_bound(class_sizes_.begin(), class_sizes_.end(), bytes) - class_sizes_.begin();
+    }
+
+    ThreadCache& threadCache() {
+        static thread_local ThreadCache cache(this);
+        return cache;
+    }
+
+    void* allocateFresh(size_t capacity) {
+        void* ptr = std::aligned_alloc(64, capacity);
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        size_t in_use = bytes_in_use_.fetch_add(capacity, std::memory_order_relaxed) + capacity;
+        notePeak(in_use + bytes_cached_.load(std::memory_order_relaxed));
         return ptr;
     }
+
+    void noteReuse(size_t capacity) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        bytes_cached_.fetch_sub(capacity, std::memory_order_relaxed);
+        bytes_in_use_.fetch_add(capacity, std::memory_order_relaxed);
+    }
+
+    void notePeak(size_t total) {
+        size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+        while (total > peak &&
+               !peak_bytes_.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {
+        }
+    }
+
+    void releaseShared(size_t cls, void* ptr, size_t capacity) {
+        if (bytes_cached_.load(std::memory_order_relaxed) + capacity > max_cached_bytes_) {
+            std::free(ptr);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(shared_[cls].mutex);
+            shared_[cls].buffers.push_back(ptr);
+        }
+        bytes_cached_.fetch_add(capacity, std::memory_order_relaxed);
+    }
 };
 
+/**
+ * Move-only array backed by SignalBufferPool. Elements are left
+ * uninitialized; HDF5 reads overwrite them anyway.
+ */
+template <typename T>
+class PooledBuffer {
+public:
+    PooledBuffer() = default;
+
+    explicit PooledBuffer(size_t count) : size_(count) {
+        if (count > 0) {
+            data_ = static_cast<T*>(SignalBufferPool::instance().acquire(count * sizeof(T), capacity_bytes_));
+        }
+    }
+
+    PooledBuffer(PooledBuffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_bytes_(std::exchange(other.capacity_bytes_, 0)) {}
+
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept {
+        if (this != &other) {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            capacity_bytes_ = std::exchange(other.capacity_bytes_, 0);
+        }
+        return *this;
+    }
+
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    ~PooledBuffer() { reset(); }
+
+    void reset() {
+        if (data_) {
+            SignalBufferPool::instance().release(data_, capacity_bytes_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+        capacity_bytes_ = 0;
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_bytes_ = 0;
+};
+
+/**
+ * One signal's samples in the element type the file stores them in, so
+ * float32 signals take 4 bytes per sample in memory and 7 on the wire
+ * instead of 8 and 11. Both halves follow H5NumericReader::Storage: samples
+ * read into pooled memory, or zero-copy views of a contiguous dataset in the
+ * mmapped file.
+ */
+using SignalBuffer = std::variant<PooledBuffer<double>, PooledBuffer<float>,
+                                  PooledBuffer<int32_t>, PooledBuffer<int64_t>,
+                                  PooledBuffer<uint32_t>, PooledBuffer<uint64_t>,
+                                  SampleView<double>, SampleView<float>,
+                                  SampleView<int32_t>, SampleView<int64_t>,
+                                  SampleView<uint32_t>, SampleView<uint64_t>>;
+
+inline size_t sampleCount(const SignalBuffer& buffer) {
+    return std::visit([](const auto& samples) { return samples.size(); }, buffer);
+}
+
+inline size_t bufferBytes(const SignalBuffer& buffer) {
+    return std::visit([](const auto& samples) {
+        return samples.size() * sizeof(*samples.data());
+    }, buffer);
+}
+
+// Valid/NaN/Inf counts of samples [first, first + count) in one SIMD pass.
+// Integer samples are always valid.
+inline SampleStats countQuality(const SignalBuffer& buffer, size_t first, size_t count) {
+    return std::visit([&](const auto& samples) {
+        return SampleStatsKernel::Compute(samples.data() + first, count);
+    }, buffer);
+}
+
+inline SampleStats countQuality(const SignalBuffer& buffer) {
+    return countQuality(buffer, 0, sampleCount(buffer));
+}
+
+// Samples [first, first + count) as one column
+inline SerializedDataColumn encodeColumn(const std::string& name, const SignalBuffer& buffer,
+                                         size_t first, size_t count) {
+    return std::visit([&](const auto& samples) {
+        return ColumnEncoder::EncodeSerializedColumn(name, samples.data() + first, count);
+    }, buffer);
+}
+
+inline SerializedDataColumn encodeColumn(const std::string& name, const SignalBuffer& buffer) {
+    return encodeColumn(name, buffer, 0, sampleCount(buffer));
+}
+
+// Whether a slice with `quality` goes out in the sparse NaN encoding: only
+// float columns that hold NaNs, and only when that is smaller
+inline bool useSparse(const SignalBuffer& buffer, const SampleStats& quality, bool enabled) {
+    if (!enabled || quality.nan == 0) {
+        return false;
+    }
+    return std::visit([&](const auto& samples) {
+        using T = std::decay_t<decltype(samples[0])>;
+        return std::is_floating_point_v<T> &&
+               ColumnEncoder::SparseIsSmaller(quality.count, quality.nan, sizeof(T));
+    }, buffer);
+}
+
+inline SerializedDataColumn encodeColumn(const std::string& name, const SignalBuffer& buffer,
+                                         size_t first, size_t count, bool sparse) {
+    if (!sparse) {
+        return encodeColumn(name, buffer, first, count);
+    }
+    return std::visit([&](const auto& samples) {
+        using T = std::decay_t<decltype(samples[0])>;
+        if constexpr (std::is_floating_point_v<T>) {
+            return ColumnEncoder::EncodeSparseSerializedColumn(name, samples.data() + first, count);
+        } else {
+            return ColumnEncoder::EncodeSerializedColumn(name, samples.data() + first, count);
+        }
+    }, buffer);
+}
+
+// Upper bound on what one sample of the buffer adds to its column
+inline size_t maxSampleBytes(const SignalBuffer& buffer) {
+    return std::visit([](const auto& samples) {
+        using T = std::decay_t<decltype(samples[0])>;
+        return ColumnEncoder::MaxSampleBytes<T>();
+    }, buffer);
+}
+
+// Sample budget of one frame whose column names are up to name_length long
+inline size_t frameSampleBudget(size_t max_frame_bytes, size_t name_length) {
+    size_t fixed = FRAME_FIXED_BYTES + name_length;
+    return max_frame_bytes > fixed ? max_frame_bytes - fixed : 0;
+}
+
+// Per-PV metadata of one column in a packed frame. Frame attributes are shared
+// by every column, so each name carries its PV as a prefix; pv_name repeats
+// once per column so the frame still matches a query on any of its PVs.
+using AttributeList = std::vector<std::pair<std::string, std::string>>;
+
+inline AttributeList packedColumnAttributes(const std::string& pv_name, const PvInfo& info,
+                                            const SampleStats& quality, size_t samples) {
+    AttributeList attributes = {
+        {"pv_name", pv_name},
+        {pv_name + ".valid_samples", std::to_string(quality.valid)},
+        {pv_name + ".nan_samples", std::to_string(quality.nan)},
+        {pv_name + ".inf_samples", std::to_string(quality.inf)},
+        {pv_name + ".data_quality_ratio", std::to_string(static_cast<double>(quality.valid) / samples)},
+    };
+    if (info.valid) {
+        attributes.emplace_back(pv_name + ".device_type", info.device_type);
+        attributes.emplace_back(pv_name + ".device_area", info.device_area);
+        attributes.emplace_back(pv_name + ".device_location", info.device_location);
+        attributes.emplace_back(pv_name + ".measurement_type", info.measurement_type);
+    }
+    return attributes;
+}
+
+inline size_t attributeBytes(const AttributeList& attributes) {
+    size_t bytes = 0;
+    for (const auto& [name, value] : attributes) {
+        bytes += ATTRIBUTE_FRAMING_BYTES + name.size() + value.size();
+    }
+    return bytes;
+}
+
+// Buckets for a signal of `samples` values: the file's timestamp runs when
+// the lengths agree, otherwise one clock at the file's dominant period
+inline std::vector<TimestampRun> signalRuns(size_t samples,
+                                            const PooledBuffer<uint64_t>& epoch_nanos,
+                                            const std::vector<TimestampRun>& runs) {
+    if (samples == epoch_nanos.size()) {
+        return runs;
+    }
+    uint64_t period = TimestampSegmenter::DominantPeriod(runs);
+    return {TimestampRun{0, samples, period ? period : 1000000000ULL, 1}};
+}
+
 /**
  * HDF5-optimized data processor with SIMD acceleration
  */
 class HDF5DataProcessor {
 private:
-    OptimizedMemoryPool memory_pool_;
     CommonClient common_client_;
 
 public:
-    // Optimized timestamp loading with error handling
-    std::unique_ptr<std::vector<uint64_t>> loadTimestampsOptimized(H5::H5File& file) {
+    // Optimized timestamp loading with error handling. Returns nanoseconds
+    // since the epoch, combining secondsPastEpoch with nanoseconds when the
+    // file has them.
+    std::unique_ptr<PooledBuffer<uint64_t>> loadTimestampsOptimized(H5::H5File& file) {
         if (!file.nameExists("secondsPastEpoch")) {
             return nullptr;
         }
@@ -192,9 +599,7 @@ public:
                 return nullptr;
             }
 
-            auto timestamps = std::make_unique<std::vector<uint64_t>>();
-            timestamps->reserve(dims[0]);
-            timestamps->resize(dims[0]);
+            auto timestamps = std::make_unique<PooledBuffer<uint64_t>>(dims[0]);
 
             // Optimized HDF5 transfer properties
             H5::DSetMemXferPropList xfer_plist;
@@ -202,8 +607,28 @@ public:
 
             seconds_ds.read(timestamps->data(), H5::PredType::NATIVE_UINT64,
                           H5::DataSpace::ALL, H5::DataSpace::ALL, xfer_plist);
-
             seconds_ds.close();
+
+            std::unique_ptr<PooledBuffer<uint64_t>> nanoseconds;
+            if (file.nameExists("nanoseconds")) {
+                H5::DataSet nanos_ds = file.openDataSet("nanoseconds");
+                hsize_t nanos_dims[1] = {0};
+                H5::DataSpace nanos_space = nanos_ds.getSpace();
+                if (nanos_space.getSimpleExtentNdims() == 1) {
+                    nanos_space.getSimpleExtentDims(nanos_dims);
+                }
+                if (nanos_dims[0] == dims[0]) {
+                    nanoseconds = std::make_unique<PooledBuffer<uint64_t>>(dims[0]);
+                    nanos_ds.read(nanoseconds->data(), H5::PredType::NATIVE_UINT64,
+                                  H5::DataSpace::ALL, H5::DataSpace::ALL, xfer_plist);
+                }
+                nanos_ds.close();
+            }
+
+            // Converted in place; each element is read before it is written
+            TimestampSegmenter::ToEpochNanos(timestamps->data(),
+                                             nanoseconds ? nanoseconds->data() : nullptr,
+                                             timestamps->size(), timestamps->data());
             return timestamps;
 
         } catch (const std::exception& e) {
@@ -213,11 +638,15 @@ public:
         }
     }
 
-    // NaN-preserving signal data reading for scientific datasets
-    std::vector<double> readSignalDataOptimized(H5::H5File& file,
-                                               const std::string& signal_name,
-                                               size_t expected_size) {
-        std::vector<double> data;
+    // NaN-preserving signal data reading for scientific datasets. With
+    // native_types, non-double numeric datasets keep their stored type. Given
+    // the file's mapping, contiguous datasets are not read at all.
+    SignalBuffer readSignalDataOptimized(H5::H5File& file,
+                                         const std::string& signal_name,
+                                         size_t expected_size,
+                                         bool native_types,
+                                         const std::shared_ptr<const MappedH5File>& mapping = nullptr) {
+        PooledBuffer<double> data;
 
         if (expected_size == 0 || expected_size > 10000000) {
             return data; // Sanity check
@@ -235,55 +664,48 @@ public:
                 return data;
             }
 
-            data.resize(dims[0]);
-
-            // CPU cache optimization
-            __builtin_prefetch(data.data(), 1, 3);
-
-            // Enhanced reading with NaN preservation
-            bool read_success = false;
+            // One type lookup, then a single read of the stored type; float32
+            // and int32 are widened in SIMD by the parser's numeric reader
+            H5NumericReader::Storage storage = H5NumericReader::classify(dataset);
+            if (mapping) {
+                SignalBuffer view;
+                if (viewContiguous(dataset, mapping, native_types, view)) {
+                    return view;
+                }
+            }
+            if (native_types) {
+                switch (storage) {
+                    case H5NumericReader::Storage::Float32:
+                        return readNative<float>(dataset, storage, dims[0]);
+                    case H5NumericReader::Storage::Int32:
+                        return readNative<int32_t>(dataset, storage, dims[0]);
+                    case H5NumericReader::Storage::Int64:
+                        return readNative<int64_t>(dataset, storage, dims[0]);
+                    case H5NumericReader::Storage::UInt32:
+                        return readNative<uint32_t>(dataset, storage, dims[0]);
+                    case H5NumericReader::Storage::UInt64:
+                        return readNative<uint64_t>(dataset, storage, dims[0]);
+                    default:
+                        break;
+                }
+            }
 
-            // Try double precision first
+            data = PooledBuffer<double>(dims[0]);
             try {
-                dataset.read(data.data(), H5::PredType::NATIVE_DOUBLE);
-                read_success = true;
-            } catch (...) {
-                // Try float with SIMD conversion
-                try {
-                    std::vector<float> float_data(dims[0]);
-                    dataset.read(float_data.data(), H5::PredType::NATIVE_FLOAT);
-                    convertFloatToDoubleOptimized(float_data.data(), data.data(), dims[0]);
-                    read_success = true;
-                } catch (...) {
-                    // Try integer types as fallback
-                    try {
-                        std::vector<int32_t> int_data(dims[0]);
-                        dataset.read(int_data.data(), H5::PredType::NATIVE_INT32);
-                        // Convert integers to doubles
-                        for (size_t i = 0; i < dims[0]; ++i) {
-                            data[i] = static_cast<double>(int_data[i]);
-                        }
-                        read_success = true;
-                    } catch (...) {
-                        // Final fallback - fill with NaN to preserve structure
-                        std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
-                        read_success = true; // Still consider this success to preserve dataset
-                    }
+                if (!H5NumericReader::read(dataset, storage, data.data(), dims[0])) {
+                    // Not numeric - fill with NaN to preserve structure
+                    std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
                 }
+            } catch (const H5::Exception&) {
+                std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
             }
 
             dataset.close();
 
-            // Don't clear data on read "failures" - preserve NaN-filled datasets
-            if (!read_success) {
-                // This shouldn't happen given our fallbacks, but ensure we have data
-                std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
-            }
-
         } catch (...) {
             // Even on dataset open failure, preserve structure with NaN
             if (data.empty() && expected_size > 0) {
-                data.resize(expected_size);
+                data = PooledBuffer<double>(expected_size);
                 std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
             }
         }
@@ -291,195 +713,785 @@ public:
         return data;
     }
 
+    // Direct chunk mode: copy the stored chunks of a compressed signal so
+    // they can be inflated after the HDF5 mutex is released. Null when the
+    // dataset does not qualify (see H5ChunkReader::fetch); those signals go
+    // through readSignalDataOptimized as before.
+    std::unique_ptr<RawChunkedDataset> fetchCompressedSignal(H5::H5File& file,
+                                                             const std::string& signal_name,
+                                                             size_t expected_size) {
+        try {
+            H5::DataSet dataset = file.openDataSet(signal_name);
+            auto raw = std::make_unique<RawChunkedDataset>();
+            if (H5ChunkReader::fetch(dataset, *raw) && raw->sample_count == expected_size) {
+                return raw;
+            }
+        } catch (...) {
+            // Fall back to the regular read, which has its own NaN handling
+        }
+        return nullptr;
+    }
+
     CommonClient& getCommonClient() { return common_client_; }
 
 private:
-    // SIMD-optimized float to double conversion with NaN preservation
-    void convertFloatToDoubleOptimized(const float* src, double* dst, size_t count) {
-        // Check for AVX2 support at runtime for production safety
-        size_t simd_count = count & ~7ULL;
-
-        #ifdef __AVX2__
-        for (size_t i = 0; i < simd_count; i += 8) {
-            __m256 float_vec = _mm256_loadu_ps(&src[i]); // Use unaligned load for safety
-
-            __m128 low = _mm256_extractf128_ps(float_vec, 0);
-            __m128 high = _mm256_extractf128_ps(float_vec, 1);
-
-            __m256d double_low = _mm256_cvtps_pd(low);
-            __m256d double_high = _mm256_cvtps_pd(high);
-
-            _mm256_storeu_pd(&dst[i], double_low);     // Unaligned store for safety
-            _mm256_storeu_pd(&dst[i + 4], double_high);
-        }
-        #endif
-
-        // Handle remaining elements with NaN preservation
-        for (size_t i = simd_count; i < count; ++i) {
-            float val = src[i];
-            if (std::isnan(val)) {
-                dst[i] = std::numeric_limits<double>::quiet_NaN();
-            } else if (std::isinf(val)) {
-                dst[i] = val > 0 ? std::numeric_limits<double>::infinity()
-                                 : -std::numeric_limits<double>::infinity();
+    // Zero-copy path: the batch carries a view of the file mapping and the
+    // builders page the samples in later, without the HDF5 mutex. Only taken
+    // when the view already has the type that will be sent.
+    bool viewContiguous(const H5::DataSet& dataset,
+                        const std::shared_ptr<const MappedH5File>& mapping,
+                        bool native_types, SignalBuffer& view) {
+        ContiguousExtent extent;
+        if (!H5ContiguousReader::locate(dataset, extent)) {
+            return false;
+        }
+        size_t count = extent.sample_count;
+        switch (native_types ? extent.storage : H5NumericReader::Storage::Float64) {
+            case H5NumericReader::Storage::Float64:
+                view = H5ContiguousReader::view<double>(extent, mapping, 0, count);
+                break;
+            case H5NumericReader::Storage::Float32:
+                view = H5ContiguousReader::view<float>(extent, mapping, 0, count);
+                break;
+            case H5NumericReader::Storage::Int32:
+                view = H5ContiguousReader::view<int32_t>(extent, mapping, 0, count);
+                break;
+            case H5NumericReader::Storage::Int64:
+                view = H5ContiguousReader::view<int64_t>(extent, mapping, 0, count);
+                break;
+            case H5NumericReader::Storage::UInt32:
+                view = H5ContiguousReader::view<uint32_t>(extent, mapping, 0, count);
+                break;
+            case H5NumericReader::Storage::UInt64:
+                view = H5ContiguousReader::view<uint64_t>(extent, mapping, 0, count);
+                break;
+            default:
+                return false;
+        }
+        // Empty for a type mismatch, a truncated file or misaligned samples
+        return sampleCount(view) == count;
+    }
+
+    // Stored-type read; a failed read degrades to a NaN-filled double column
+    template <typename T>
+    SignalBuffer readNative(const H5::DataSet& dataset, H5NumericReader::Storage storage,
+                            size_t count) {
+        PooledBuffer<T> samples(count);
+        try {
+            dataset.read(samples.data(), H5NumericReader::memoryType(storage));
+            return samples;
+        } catch (const H5::Exception&) {
+            PooledBuffer<double> data(count);
+            std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
+            return data;
+        }
+    }
+};
+
+/**
+ * Counter for a set of tasks or other units of work (e.g. files completing
+ * in the pipeline). wait() blocks on a condition variable instead of polling.
+ */
+class TaskGroup {
+private:
+    std::atomic<size_t> pending_{0};
+    std::mutex mutex_;
+    std::condition_variable done_cv_;
+
+public:
+    void add(size_t count = 1) {
+        pending_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    // The decrement happens under the mutex so a waiter that sees zero cannot
+    // destroy the group while the last done() is still using it
+    void done() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done_cv_.notify_all();
+        }
+    }
+
+    size_t pending() const {
+        return pending_.load(std::memory_order_acquire);
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return pending() == 0; });
+    }
+
+    // Returns false if the group was still busy at the timeout
+    template<class Rep, class Period>
+    bool waitFor(const std::chrono::duration<Rep, Period>& timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return done_cv_.wait_for(lock, timeout, [this] { return pending() == 0; });
+    }
+};
+
+/**
+ * Chase-Lev work-stealing deque. The owning worker pushes and pops at the
+ * bottom without locks; other workers steal from the top. The ring grows
+ * when full and retired rings are kept until the deque is destroyed, since
+ * a concurrent thief may still be reading one.
+ */
+template<typename T>
+class WorkStealingDeque {
+private:
+    struct Ring {
+        int64_t capacity;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+
+        explicit Ring(int64_t cap) : capacity(cap), slots(new std::atomic<T*>[cap]) {}
+
+        T* get(int64_t i) const { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, T* item) { slots[i & (capacity - 1)].store(item, std::memory_order_relaxed); }
+
+        Ring* grow(int64_t top, int64_t bottom) const {
+            Ring* bigger = new Ring(capacity * 2);
+            for (int64_t i = top; i < bottom; ++i) {
+                bigger->put(i, get(i));
+            }
+            return bigger;
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Ring*> ring_;
+    std::vector<std::unique_ptr<Ring>> retired_;  // Owner only
+
+public:
+    explicit WorkStealingDeque(int64_t initial_capacity = 256)
+        : ring_(new Ring(initial_capacity)) {}
+
+    ~WorkStealingDeque() {
+        delete ring_.load(std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only
+    void push(T* item) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        if (b - t > ring->capacity - 1) {
+            Ring* bigger = ring->grow(t, b);
+            retired_.emplace_back(ring);
+            ring_.store(bigger, std::memory_order_release);
+            ring = bigger;
+        }
+        ring->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only; LIFO for cache locality
+    T* pop() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = ring->get(b);
+        if (t == b) {
+            // Last item: race any thief for it
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Any thread; FIFO
+    T* steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return nullptr;
+        }
+
+        Ring* ring = ring_.load(std::memory_order_acquire);
+        T* item = ring->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;  // Lost the race to the owner or another thief
+        }
+        return item;
+    }
+
+    bool empty() const {
+        return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+    }
+};
+
+/**
+ * Work-stealing scheduler for the reader stage. Each worker runs tasks from
+ * its own Chase-Lev deque, steals from the others when that is empty, and
+ * parks on a condition variable when there is nothing anywhere, so idle
+ * workers cost nothing and a submit wakes exactly one of them. Tasks
+ * submitted from outside the pool go through a shared injection queue.
+ */
+class WorkStealingScheduler {
+public:
+    struct Stats {
+        uint64_t tasks_run = 0;
+        uint64_t steals = 0;
+        uint64_t parks = 0;
+    };
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group;
+    };
+
+    struct alignas(64) Worker {
+        WorkStealingDeque<Task> deque;
+        std::atomic<uint64_t> tasks_run{0};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<uint64_t> parks{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex inject_mutex_;
+    std::deque<Task*> injected_;
+    std::atomic<size_t> injected_count_{0};
+
+    // Parking: a worker records the epoch, announces itself as a sleeper,
+    // looks for work once more and only then waits for the epoch to move.
+    // Every submit bumps the epoch before checking for sleepers, so a task
+    // published during that window is never missed.
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+    std::atomic<uint64_t> epoch_{0};
+    std::atomic<size_t> sleepers_{0};
+    std::atomic<bool> stop_{false};
+
+    static thread_local WorkStealingScheduler* current_scheduler_;
+    static thread_local size_t current_worker_;
+
+public:
+    explicit WorkStealingScheduler(size_t thread_count) {
+        thread_count = std::max<size_t>(1, thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+
+        for (size_t i = 0; i < thread_count; ++i) {
+            threads_.emplace_back([this, i] {
+                // Set CPU affinity for optimal performance
+                cpu_set_t cpuset;
+                CPU_ZERO(&cpuset);
+                CPU_SET(i % std::thread::hardware_concurrency(), &cpuset);
+                pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+
+                current_scheduler_ = this;
+                current_worker_ = i;
+                workerLoop(i);
+            });
+        }
+    }
+
+    ~WorkStealingScheduler() {
+        stop_.store(true);
+        {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            epoch_.fetch_add(1);
+        }
+        park_cv_.notify_all();
+
+        for (auto& thread : threads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+
+        // Tasks never run are dropped without touching their groups
+        for (auto& worker : workers_) {
+            while (Task* task = worker->deque.pop()) {
+                delete task;
+            }
+        }
+        for (Task* task : injected_) {
+            delete task;
+        }
+    }
+
+    template<class F>
+    void submit(TaskGroup& group, F&& f) {
+        group.add();
+        Task* task = new Task{std::function<void()>(std::forward<F>(f)), &group};
+
+        if (current_scheduler_ == this) {
+            workers_[current_worker_]->deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            injected_.push_back(task);
+            injected_count_.fetch_add(1, std::memory_order_release);
+        }
+        wakeOne();
+    }
+
+    // Join a group. A worker thread keeps running tasks while it waits so a
+    // task may wait on subtasks without starving the pool.
+    void wait(TaskGroup& group) {
+        if (current_scheduler_ != this) {
+            group.wait();
+            return;
+        }
+        size_t index = current_worker_;
+        while (group.pending() > 0) {
+            if (Task* task = findTask(index)) {
+                run(index, task);
             } else {
-                dst[i] = static_cast<double>(val);
+                std::this_thread::yield();
+            }
+        }
+        group.wait();  // Returns at once; synchronizes with the final done()
+    }
+
+    Stats stats() const {
+        Stats total;
+        for (const auto& worker : workers_) {
+            total.tasks_run += worker->tasks_run.load(std::memory_order_relaxed);
+            total.steals += worker->steals.load(std::memory_order_relaxed);
+            total.parks += worker->parks.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    size_t size() const {
+        return workers_.size();
+    }
+
+private:
+    void workerLoop(size_t index) {
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (Task* task = findTask(index)) {
+                run(index, task);
+                continue;
+            }
+            park(index);
+        }
+    }
+
+    Task* findTask(size_t index) {
+        Worker& self = *workers_[index];
+        if (Task* task = self.deque.pop()) {
+            return task;
+        }
+
+        if (injected_count_.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(inject_mutex_);
+            if (!injected_.empty()) {
+                Task* task = injected_.front();
+                injected_.pop_front();
+                injected_count_.fetch_sub(1, std::memory_order_relaxed);
+                return task;
             }
         }
+
+        const size_t count = workers_.size();
+        for (size_t offset = 1; offset < count; ++offset) {
+            if (Task* task = workers_[(index + offset) % count]->deque.steal()) {
+                self.steals.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    bool hasWork() const {
+        if (injected_count_.load(std::memory_order_seq_cst) > 0) {
+            return true;
+        }
+        for (const auto& worker : workers_) {
+            if (!worker->deque.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void park(size_t index) {
+        uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+
+        if (!hasWork() && !stop_.load(std::memory_order_seq_cst)) {
+            workers_[index]->parks.fetch_add(1, std::memory_order_relaxed);
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            park_cv_.wait(lock, [this, epoch] {
+                return epoch_.load(std::memory_order_seq_cst) != epoch || stop_.load();
+            });
+        }
+
+        sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void wakeOne() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            park_cv_.notify_one();
+        }
+    }
+
+    void run(size_t index, Task* task) {
+        std::unique_ptr<Task> owned(task);
+        try {
+            owned->fn();
+        } catch (...) {
+            // Tasks report failures through their own state
+        }
+        workers_[index]->tasks_run.fetch_add(1, std::memory_order_relaxed);
+        owned->group->done();
+    }
+};
+
+thread_local WorkStealingScheduler* WorkStealingScheduler::current_scheduler_ = nullptr;
+thread_local size_t WorkStealingScheduler::current_worker_ = 0;
+
+/**
+ * Bounded queue between pipeline stages with byte-based backpressure.
+ * Counting bytes rather than items keeps a burst of large signals from
+ * exhausting memory while many small ones still flow freely.
+ */
+template<typename T>
+class ByteBoundedQueue {
+private:
+    std::deque<std::pair<T, size_t>> items_;
+    size_t capacity_bytes_;
+    size_t queued_bytes_ = 0;
+    size_t peak_bytes_ = 0;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+
+public:
+    explicit ByteBoundedQueue(size_t capacity_bytes) : capacity_bytes_(capacity_bytes) {}
+
+    // Blocks while the byte budget is exhausted. An item larger than the whole
+    // budget is admitted once the queue has drained so it cannot deadlock.
+    bool push(T item, size_t bytes) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&] {
+            return closed_ || queued_bytes_ == 0 || queued_bytes_ + bytes <= capacity_bytes_;
+        });
+        if (closed_) {
+            return false;
+        }
+
+        queued_bytes_ += bytes;
+        peak_bytes_ = std::max(peak_bytes_, queued_bytes_);
+        items_.emplace_back(std::move(item), bytes);
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Returns false once the queue is closed and fully drained
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return false;
+        }
+
+        item = std::move(items_.front().first);
+        queued_bytes_ -= items_.front().second;
+        items_.pop_front();
+        lock.unlock();
+        not_full_.notify_all();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    size_t peakBytes() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return peak_bytes_;
     }
 };
 
 /**
- * Production-grade adaptive thread pool with resource management
+ * Recycles protobuf arenas between request batches. Each arena keeps a
+ * pool-owned initial block across Reset(), so in steady state a batch's
+ * request envelopes, attributes and event metadata are carved out of memory
+ * that is already mapped, and the whole batch is released with one Reset()
+ * instead of a free() per message.
  */
-class ProductionThreadPool {
+class RequestArenaPool {
 private:
-    struct WorkQueue {
-        std::queue<std::function<void()>> tasks;
-        std::mutex mutex;
-        std::condition_variable condition;
+    struct PooledArena {
+        std::unique_ptr<char[]> initial_block;
+        std::unique_ptr<google::protobuf::Arena> arena;
     };
 
-    std::vector<std::thread> workers_;
-    std::vector<std::unique_ptr<WorkQueue>> work_queues_;
-    std::atomic<bool> stop_{false};
-    std::atomic<size_t> active_workers_{0};
+    size_t initial_block_bytes_;
+    size_t max_pooled_;
+    std::vector<std::unique_ptr<PooledArena>> free_;
+    std::mutex mutex_;
 
 public:
-    ProductionThreadPool() {
-        size_t thread_count = std::min(OPTIMAL_WORKER_THREADS,
-                                      std::max(2UL, static_cast<size_t>(std::thread::hardware_concurrency())));
-
-        work_queues_.resize(thread_count);
-        for (size_t i = 0; i < thread_count; ++i) {
-            work_queues_[i] = std::make_unique<WorkQueue>();
-        }
-
-        // Create optimized worker threads
-        for (size_t i = 0; i < thread_count; ++i) {
-            workers_.emplace_back([this, i, thread_count] {
-                active_workers_.fetch_add(1);
-
-                // Set CPU affinity for optimal performance
-                cpu_set_t cpuset;
-                CPU_ZERO(&cpuset);
-                CPU_SET(i % std::thread::hardware_concurrency(), &cpuset);
-                pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
-
-                while (!stop_.load(std::memory_order_relaxed)) {
-                    std::function<void()> task;
-
-                    // Try own queue first (cache locality)
-                    if (tryGetTask(i, task)) {
-                        task();
-                        continue;
-                    }
-
-                    // Work stealing with exponential backoff
-                    bool found = false;
-                    for (size_t attempt = 0; attempt < thread_count && !found; ++attempt) {
-                        size_t steal_idx = (i + attempt + 1) % thread_count;
-                        if (tryGetTask(steal_idx, task)) {
-                            task();
-                            found = true;
-                        }
-                    }
+    using Handle = std::shared_ptr<google::protobuf::Arena>;
 
-                    if (!found) {
-                        std::this_thread::sleep_for(std::chrono::microseconds(100));
-                    }
-                }
+    RequestArenaPool(size_t initial_block_bytes, size_t max_pooled)
+        : initial_block_bytes_(initial_block_bytes), max_pooled_(max_pooled) {}
 
-                active_workers_.fetch_sub(1);
-            });
+    // The handle returns the arena to the pool when its last copy is dropped
+    Handle acquire() {
+        std::unique_ptr<PooledArena> pooled;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                pooled = std::move(free_.back());
+                free_.pop_back();
+            }
         }
-    }
 
-    template<class F>
-    void enqueue(F&& f) {
-        static std::atomic<size_t> round_robin{0};
-        size_t queue_idx = round_robin.fetch_add(1) % work_queues_.size();
+        if (!pooled) {
+            pooled = std::make_unique<PooledArena>();
+            pooled->initial_block = std::make_unique<char[]>(initial_block_bytes_);
 
-        auto& queue = work_queues_[queue_idx];
-        {
-            std::lock_guard<std::mutex> lock(queue->mutex);
-            queue->tasks.emplace(std::forward<F>(f));
+            google::protobuf::ArenaOptions options;
+            options.initial_block = pooled->initial_block.get();
+            options.initial_block_size = initial_block_bytes_;
+            options.start_block_size = initial_block_bytes_;
+            options.max_block_size = 4 * initial_block_bytes_;
+            pooled->arena = std::make_unique<google::protobuf::Arena>(options);
         }
-        queue->condition.notify_one();
-    }
 
-    ~ProductionThreadPool() {
-        stop_.store(true);
-        for (auto& queue : work_queues_) {
-            queue->condition.notify_all();
-        }
-        for (auto& worker : workers_) {
-            if (worker.joinable()) {
-                worker.join();
-            }
-        }
+        google::protobuf::Arena* arena = pooled->arena.get();
+        return Handle(arena, [this, raw = pooled.release()](google::protobuf::Arena*) {
+            release(std::unique_ptr<PooledArena>(raw));
+        });
     }
 
 private:
-    bool tryGetTask(size_t queue_idx, std::function<void()>& task) {
-        auto& queue = work_queues_[queue_idx];
-        std::unique_lock<std::mutex> lock(queue->mutex, std::try_to_lock);
+    void release(std::unique_ptr<PooledArena> pooled) {
+        pooled->arena->Reset();  // Runs message destructors, keeps the initial block
 
-        if (!lock.owns_lock() || queue->tasks.empty()) {
-            return false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.size() < max_pooled_) {
+            free_.push_back(std::move(pooled));
         }
-
-        task = std::move(queue->tasks.front());
-        queue->tasks.pop();
-        return true;
     }
 };
 
+// Tracks one file through the pipeline. The reader holds one reference while
+// it walks the file and every in-flight batch holds another; the file is
+// complete when the count drops to zero.
+struct FileTicket {
+    std::string filepath;
+    FileMetadata metadata;
+    std::shared_ptr<const PooledBuffer<uint64_t>> timestamps;  // Nanoseconds since the epoch
+    std::vector<TimestampRun> runs;  // One request per run and signal
+    std::chrono::high_resolution_clock::time_point start;
+    std::atomic<size_t> pending{1};
+    std::atomic<bool> failed{false};
+
+    explicit FileTicket(const std::string& path)
+        : filepath(path), metadata(path), start(std::chrono::high_resolution_clock::now()) {}
+};
+
+// Reader stage -> build stage. In direct chunk mode `compressed` runs
+// parallel to signal_data; a non-null entry still has to be decoded into the
+// (empty) buffer at the same index.
+struct SignalBatch {
+    std::shared_ptr<FileTicket> ticket;
+    std::vector<std::string> signal_names;
+    std::vector<SignalBuffer> signal_data;
+    std::vector<std::unique_ptr<RawChunkedDataset>> compressed;
+};
+
+// Build stage -> send stage. The requests live on `arena`, which goes back to
+// the pool (and is reset) when the last holder drops the batch.
+struct RequestBatch {
+    std::shared_ptr<FileTicket> ticket;
+    std::shared_ptr<google::protobuf::Arena> arena;
+    std::vector<IngestDataRequest*> requests;
+    std::vector<size_t> column_counts;  // Signals carried by each request
+};
+
 /**
  * Production-grade H5 processor optimized for non-thread-safe HDF5
+ *
+ * Runs as a three-stage pipeline so disk reads overlap network round-trips:
+ *   reader   - processFile(); the only stage that holds the HDF5 mutex
+ *   builder  - turns raw signal batches into IngestDataRequests, first
+ *              inflating any direct-read chunks on the decode pool
+ *   sender   - N threads issuing the ingestion RPCs concurrently
  */
 class ProductionH5Processor {
+public:
+    using FileCompletionCallback = std::function<void(const std::string& filepath, bool success)>;
+
 private:
     std::string output_dir_;
     std::atomic<size_t> file_counter_{0};
     IngestionClient* ingest_client_;
     std::string provider_id_;
-    std::mutex ingest_mutex_;
     HDF5DataProcessor data_processor_;
+    ProcessingStats& stats_;
+    FileCompletionCallback on_file_complete_;
+    bool bulk_mode_;
+    bool async_mode_;
+    size_t bulk_window_;
+    size_t pack_columns_;
+    size_t max_frame_bytes_;
+    bool native_types_;
+    bool direct_chunks_;
+    bool memory_mapping_;
+    bool sparse_nan_;
 
     // Performance monitoring
     std::atomic<double> avg_file_time_{0.0};
     std::atomic<size_t> processed_count_{0};
 
+    // Pipeline stages. The arena pool is declared first so it outlives any
+    // batch still sitting in a queue during teardown.
+    RequestArenaPool arena_pool_;
+    ByteBoundedQueue<SignalBatch> build_queue_;
+    ByteBoundedQueue<RequestBatch> send_queue_;
+    std::vector<std::thread> builder_threads_;
+    std::vector<std::thread> sender_threads_;
+    std::atomic<bool> shut_down_{false};
+
+    // Direct chunk mode: chunk inflation, fed by the builders
+    std::unique_ptr<WorkStealingScheduler> decode_scheduler_;
+
     // HDF5 thread safety - CRITICAL for non-thread-safe HDF5
     static std::mutex hdf5_global_mutex_;
 
 public:
-    ProductionH5Processor(const std::string& output_dir, IngestionClient* client, const std::string& provider_id)
-        : output_dir_(output_dir), ingest_client_(client), provider_id_(provider_id) {
+    ProductionH5Processor(const std::string& output_dir, IngestionClient* client,
+                          const std::string& provider_id, ProcessingStats& stats,
+                          const ProcessorOptions& options)
+        : output_dir_(output_dir), ingest_client_(client), provider_id_(provider_id), stats_(stats),
+          bulk_mode_(options.bulk), async_mode_(options.async),
+          bulk_window_(options.window ? options.window : DEFAULT_BULK_WINDOW),
+          pack_columns_(std::max<size_t>(1, options.pack_columns)),
+          max_frame_bytes_(options.max_frame_bytes),
+          native_types_(options.native_types),
+          direct_chunks_(options.direct_chunks),
+          memory_mapping_(options.memory_mapping),
+          sparse_nan_(options.sparse_nan),
+          arena_pool_(ARENA_INITIAL_BLOCK_BYTES, BUILDER_THREADS + SENDER_THREADS * 2),
+          build_queue_(BUILD_QUEUE_BYTES), send_queue_(SEND_QUEUE_BYTES) {
         std::filesystem::create_directories(output_dir);
+
+        if (direct_chunks_) {
+            decode_scheduler_ = std::make_unique<WorkStealingScheduler>(decodeThreads());
+        }
+        for (size_t i = 0; i < BUILDER_THREADS; ++i) {
+            builder_threads_.emplace_back([this] { builderLoop(); });
+        }
+        for (size_t i = 0; i < SENDER_THREADS; ++i) {
+            if (bulk_mode_) {
+                sender_threads_.emplace_back([this] { bulkSenderLoop(); });
+            } else if (async_mode_) {
+                sender_threads_.emplace_back([this] { asyncSenderLoop(); });
+            } else {
+                sender_threads_.emplace_back([this] { senderLoop(); });
+            }
+        }
+    }
+
+    ~ProductionH5Processor() {
+        shutdown();
+    }
+
+    // Invoked once per file after its last batch has been sent (or it failed)
+    void setFileCompletionCallback(FileCompletionCallback callback) {
+        on_file_complete_ = std::move(callback);
+    }
+
+    // Drain the pipeline front to back: builders flush into the send stage
+    // before the senders are told to stop.
+    void shutdown() {
+        if (shut_down_.exchange(true)) {
+            return;
+        }
+
+        build_queue_.close();
+        for (auto& thread : builder_threads_) {
+            if (thread.joinable()) thread.join();
+        }
+
+        send_queue_.close();
+        for (auto& thread : sender_threads_) {
+            if (thread.joinable()) thread.join();
+        }
     }
 
     /**
-     * Process single H5 file with full thread safety for non-thread-safe HDF5
+     * Reader stage: read one H5 file under the HDF5 mutex and hand its signals
+     * to the build stage. Returns once the file has been read; completion is
+     * reported through the file completion callback after the sends finish.
      */
-    bool processFile(const std::string& filepath, ProcessingStats& stats) {
-        auto start = std::chrono::high_resolution_clock::now();
+    bool processFile(const std::string& filepath) {
+        auto ticket = std::make_shared<FileTicket>(filepath);
+
+        bool read_ok = readFile(ticket);
+        if (!read_ok) {
+            ticket->failed.store(true);
+        }
+
+        releaseTicket(ticket);
+        return read_ok;
+    }
+
+    double getAverageProcessingTime() const {
+        return avg_file_time_.load();
+    }
+
+    size_t getPeakQueuedBytes() {
+        return build_queue_.peakBytes() + send_queue_.peakBytes();
+    }
+
+    static size_t decodeThreads() {
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+private:
+    bool readFile(const std::shared_ptr<FileTicket>& ticket) {
+        const std::string& filepath = ticket->filepath;
 
         try {
             // Fast file validation
             struct stat file_stat;
             if (stat(filepath.c_str(), &file_stat) != 0) {
-                stats.files_failed.fetch_add(1);
                 return false;
             }
 
             size_t file_size = file_stat.st_size;
-            stats.bytes_processed.fetch_add(file_size);
+            stats_.bytes_processed.fetch_add(file_size);
 
             // Skip too small or too large files
             if (file_size < 1024 || file_size > 10ULL * 1024 * 1024 * 1024) {
-                stats.files_failed.fetch_add(1);
                 return false;
             }
 
@@ -491,23 +1503,22 @@ public:
             fapl.setCache(521, 75, 4*1024*1024, 0.75); // Conservative cache settings
 
             H5::H5File file(filepath, H5F_ACC_RDONLY, H5::FileCreatPropList::DEFAULT, fapl);
-
-            // Always extract metadata (now robust)
-            FileMetadata file_metadata(filepath);
+            std::shared_ptr<const MappedH5File> mapping =
+                memory_mapping_ ? MappedH5File::open(filepath) : nullptr;
 
             // Load timestamps with validation
             auto timestamps = data_processor_.loadTimestampsOptimized(file);
             if (!timestamps || timestamps->empty()) {
                 file.close();
-                stats.files_failed.fetch_add(1);
                 return false;
             }
+            ticket->runs = TimestampSegmenter::Segment(timestamps->data(), timestamps->size());
+            ticket->timestamps = std::move(timestamps);
 
             // Get signal names efficiently
             auto signal_names = getSignalNamesOptimized(file);
             if (signal_names.empty()) {
                 file.close();
-                stats.files_failed.fetch_add(1);
                 return false;
             }
 
@@ -516,89 +1527,334 @@ public:
                 signal_names.resize(MAX_SIGNALS_PER_BATCH);
             }
 
-            // Process signals efficiently
-            bool success = processSignalsOptimized(file, signal_names, timestamps.get(),
-                                                  file_metadata, filepath, stats);
-
-            file.close();
-            // HDF5 mutex automatically released here
-
-            // Update performance metrics
-            auto end = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration<double>(end - start).count();
-            updatePerformanceMetrics(duration);
+            // A packed frame can only draw on the signals of one batch
+            const size_t OPTIMAL_BATCH_SIZE = std::max(READ_BATCH_SIGNALS, pack_columns_);
+            const size_t sample_count = ticket->timestamps->size();
+
+            for (size_t batch_start = 0; batch_start < signal_names.size(); batch_start += OPTIMAL_BATCH_SIZE) {
+                size_t batch_end = std::min(batch_start + OPTIMAL_BATCH_SIZE, signal_names.size());
+
+                SignalBatch batch;
+                batch.ticket = ticket;
+                batch.signal_names.assign(signal_names.begin() + batch_start,
+                                          signal_names.begin() + batch_end);
+                batch.signal_data.reserve(batch.signal_names.size());
+
+                size_t batch_bytes = 0;
+                for (const auto& name : batch.signal_names) {
+                    // Compressed signals are only copied here; the builders inflate them
+                    if (direct_chunks_) {
+                        auto raw = data_processor_.fetchCompressedSignal(file, name, sample_count);
+                        if (raw) {
+                            batch_bytes += raw->storedBytes();
+                            batch.signal_data.emplace_back();
+                            batch.compressed.push_back(std::move(raw));
+                            continue;
+                        }
+                        batch.compressed.emplace_back();
+                    }
+                    batch.signal_data.push_back(data_processor_.readSignalDataOptimized(
+                        file, name, sample_count, native_types_, mapping));
+                    batch_bytes += bufferBytes(batch.signal_data.back());
+                }
 
-            if (success) {
-                stats.files_processed.fetch_add(1);
-            } else {
-                stats.files_failed.fetch_add(1);
+                // Blocks here when the builders fall behind (backpressure)
+                ticket->pending.fetch_add(1);
+                if (!build_queue_.push(std::move(batch), batch_bytes)) {
+                    ticket->pending.fetch_sub(1);
+                    file.close();
+                    return false;
+                }
             }
 
-            return success;
+            file.close();
+            // HDF5 mutex automatically released here
+            return true;
 
         } catch (const std::exception& e) {
-            stats.files_failed.fetch_add(1);
             return false;
         } catch (...) {
-            stats.files_failed.fetch_add(1);
             return false;
         }
     }
 
-    double getAverageProcessingTime() const {
-        return avg_file_time_.load();
+    // Build stage: request construction runs without the HDF5 mutex
+    void builderLoop() {
+        for (;;) {
+            SignalBatch batch;
+            if (!build_queue_.pop(batch)) {
+                return;
+            }
+
+            auto ticket = batch.ticket;
+            auto arena = arena_pool_.acquire();
+            std::vector<IngestDataRequest*> requests;
+            std::vector<size_t> column_counts;
+
+            try {
+                decodeCompressedSignals(batch);
+
+                std::vector<PvInfo> pv_infos;
+                pv_infos.reserve(batch.signal_names.size());
+                for (const auto& name : batch.signal_names) {
+                    pv_infos.emplace_back(name);
+                }
+
+                if (pack_columns_ > 1) {
+                    requests = createPackedIngestRequests(
+                        arena.get(), batch.signal_names, batch.signal_data, pv_infos,
+                        ticket->metadata, *ticket->timestamps, ticket->runs,
+                        ticket->filepath, column_counts);
+                } else {
+                    requests = createIngestRequestsBatch(
+                        arena.get(), batch.signal_names, batch.signal_data, pv_infos,
+                        ticket->metadata, *ticket->timestamps, ticket->runs,
+                        ticket->filepath, column_counts);
+                }
+            } catch (...) {
+                ticket->failed.store(true);
+                requests.clear();
+            }
+
+            // Hand the raw buffers back to the pool before possibly blocking on the send stage
+            batch.signal_data.clear();
+
+            if (requests.empty()) {
+                releaseTicket(ticket);
+                continue;
+            }
+
+            size_t request_bytes = 0;
+            for (const auto* request : requests) {
+                request_bytes += request->ByteSizeLong();
+            }
+
+            RequestBatch request_batch{ticket, std::move(arena), std::move(requests), std::move(column_counts)};
+            if (!send_queue_.push(std::move(request_batch), request_bytes)) {
+                ticket->failed.store(true);
+                releaseTicket(ticket);
+            }
+        }
     }
 
-private:
-    // Optimized signal processing within HDF5 mutex protection
-    bool processSignalsOptimized(H5::H5File& file,
-                                const std::vector<std::string>& signal_names,
-                                const std::vector<uint64_t>* timestamps,
-                                const FileMetadata& file_metadata,
-                                const std::string& filepath,
-                                ProcessingStats& stats) {
-
-        const size_t OPTIMAL_BATCH_SIZE = 32;
-        auto& common = data_processor_.getCommonClient();
+    /**
+     * Inflate the direct-read signals of a batch. Every chunk of every
+     * signal is its own decode task and the builder waits once for all of
+     * them, so one batch keeps the whole decode pool busy. The result matches
+     * readSignalDataOptimized: stored type, or double with --double-columns;
+     * a corrupt chunk turns its signal into a NaN-filled double column.
+     */
+    void decodeCompressedSignals(SignalBatch& batch) {
+        if (batch.compressed.empty()) {
+            return;
+        }
+
+        std::unique_ptr<std::atomic<bool>[]> corrupt(new std::atomic<bool>[batch.compressed.size()]());
+        TaskGroup group;
+        for (size_t i = 0; i < batch.compressed.size(); ++i) {
+            if (!batch.compressed[i]) {
+                continue;
+            }
+            const RawChunkedDataset& raw = *batch.compressed[i];
+            switch (raw.storage) {
+                case H5NumericReader::Storage::Float32:
+                    submitChunkDecodes<float>(raw, batch.signal_data[i], group, corrupt[i]);
+                    break;
+                case H5NumericReader::Storage::Int32:
+                    submitChunkDecodes<int32_t>(raw, batch.signal_data[i], group, corrupt[i]);
+                    break;
+                case H5NumericReader::Storage::Int64:
+                    submitChunkDecodes<int64_t>(raw, batch.signal_data[i], group, corrupt[i]);
+                    break;
+                case H5NumericReader::Storage::UInt32:
+                    submitChunkDecodes<uint32_t>(raw, batch.signal_data[i], group, corrupt[i]);
+                    break;
+                case H5NumericReader::Storage::UInt64:
+                    submitChunkDecodes<uint64_t>(raw, batch.signal_data[i], group, corrupt[i]);
+                    break;
+                default:
+                    submitChunkDecodes<double>(raw, batch.signal_data[i], group, corrupt[i]);
+                    break;
+            }
+        }
+        decode_scheduler_->wait(group);
 
-        for (size_t batch_start = 0; batch_start < signal_names.size(); batch_start += OPTIMAL_BATCH_SIZE) {
-            size_t batch_end = std::min(batch_start + OPTIMAL_BATCH_SIZE, signal_names.size());
+        for (size_t i = 0; i < batch.compressed.size(); ++i) {
+            if (batch.compressed[i] && corrupt[i].load()) {
+                PooledBuffer<double> data(batch.compressed[i]->sample_count);
+                std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
+                batch.signal_data[i] = std::move(data);
+            }
+        }
+        batch.compressed.clear();
+    }
 
-            // Sequential processing within HDF5 mutex (required for thread safety)
-            std::vector<std::vector<double>> signal_data(batch_end - batch_start);
-            std::vector<PvInfo> pv_infos(batch_end - batch_start, PvInfo(""));
+    // Allocate `target` for one signal stored as `Stored` and queue a decode
+    // task per chunk. Chunks are decoded straight into the buffer, or into a
+    // per-thread scratch array and widened when double columns are wanted.
+    template <typename Stored>
+    void submitChunkDecodes(const RawChunkedDataset& raw, SignalBuffer& target,
+                            TaskGroup& group, std::atomic<bool>& corrupt) {
+        if (native_types_ || std::is_same_v<Stored, double>) {
+            PooledBuffer<Stored> samples(raw.sample_count);
+            submitChunkDecodes<Stored>(raw, samples.data(), group, corrupt);
+            target = std::move(samples);
+        } else {
+            PooledBuffer<double> samples(raw.sample_count);
+            submitChunkDecodes<Stored>(raw, samples.data(), group, corrupt);
+            target = std::move(samples);
+        }
+    }
 
-            for (size_t i = batch_start; i < batch_end; ++i) {
-                size_t local_idx = i - batch_start;
+    // The buffer behind `out` only moves its pointer along, so it may be
+    // handed over before the tasks have run
+    template <typename Stored, typename Out>
+    void submitChunkDecodes(const RawChunkedDataset& raw, Out* out,
+                            TaskGroup& group, std::atomic<bool>& corrupt) {
+        for (size_t chunk = 0; chunk < raw.chunks.size(); ++chunk) {
+            decode_scheduler_->submit(group, [&raw, &corrupt, out, chunk] {
+                Out* dst = out + raw.chunkOffset(chunk);
+                if constexpr (std::is_same_v<Out, Stored>) {
+                    if (!H5ChunkReader::decodeChunk(raw, chunk, dst)) {
+                        corrupt.store(true);
+                    }
+                } else {
+                    thread_local std::vector<Stored> scratch;
+                    scratch.resize(raw.chunkLength(chunk));
+                    if (!H5ChunkReader::decodeChunk(raw, chunk, scratch.data())) {
+                        corrupt.store(true);
+                        return;
+                    }
+                    if constexpr (std::is_same_v<Stored, float> || std::is_same_v<Stored, int32_t>) {
+                        H5NumericReader::widen(scratch.data(), dst, scratch.size());
+                    } else {
+                        for (size_t i = 0; i < scratch.size(); ++i) {
+                            dst[i] = static_cast<double>(scratch[i]);
+                        }
+                    }
+                }
+            });
+        }
+    }
 
-                // Read signal data (protected by HDF5 mutex)
-                signal_data[local_idx] = data_processor_.readSignalDataOptimized(
-                    file, signal_names[i], timestamps->size());
+    // Send stage: several senders keep multiple RPCs in flight
+    void senderLoop() {
+        for (;;) {
+            RequestBatch batch;
+            if (!send_queue_.pop(batch)) {
+                return;
+            }
 
-                // Parse PV info (thread-safe operation)
-                pv_infos[local_idx] = PvInfo(signal_names[i]);
+            if (!sendToIngestionOptimized(batch)) {
+                batch.ticket->failed.store(true);
             }
 
-            // Create ingestion requests
-            std::vector<std::string> batch_signal_names(
-                signal_names.begin() + batch_start,
-                signal_names.begin() + batch_end
-            );
+            releaseTicket(batch.ticket);
+        }
+    }
 
-            auto ingest_requests = createIngestRequestsBatch(
-                batch_signal_names, signal_data, pv_infos,
-                file_metadata, *timestamps, filepath);
+    /**
+     * Bulk send stage: each sender owns one long-lived bidi stream and keeps up
+     * to bulk_window_ requests unacknowledged on it. A file's ticket holds one
+     * reference per request and is released from the ack callback, so a file
+     * only completes once the service has acknowledged all of its signals.
+     */
+    void bulkSenderLoop() {
+        std::unique_ptr<IngestionClient::BulkIngestionSession> session;
 
-            // Send to ingestion (can be done outside HDF5 mutex if needed)
-            if (!ingest_requests.empty()) {
-                if (!sendToIngestionOptimized(ingest_requests)) {
-                    return false;
+        for (;;) {
+            RequestBatch batch;
+            if (!send_queue_.pop(batch)) {
+                break;
+            }
+
+            auto ticket = batch.ticket;
+            ticket->pending.fetch_add(batch.requests.size());
+
+            for (size_t i = 0; i < batch.requests.size(); ++i) {
+                const auto& request = *batch.requests[i];
+                // Reopen after a broken stream; its outstanding requests were already failed
+                if (!session || !session->IsOpen()) {
+                    session = ingest_client_->CreateBulkIngestionSession(bulk_window_);
                 }
-                stats.signals_processed.fetch_add(ingest_requests.size());
+
+                size_t columns = batch.column_counts[i];
+                session->Send(request, [this, ticket, columns](const IngestDataResponse& response) {
+                    if (response.has_ackresult()) {
+                        stats_.signals_processed.fetch_add(columns);
+                    } else {
+                        ticket->failed.store(true);
+                    }
+                    releaseTicket(ticket);
+                });
             }
+
+            // Recycle the batch arena now; the stream has its own copy of the bytes
+            batch.requests.clear();
+            batch.arena.reset();
+            releaseTicket(ticket);
         }
 
-        return true;
+        if (session) {
+            session->Finish();
+        }
+    }
+
+    /**
+     * Async send stage: senders only hand requests to the client's completion
+     * queues, blocking when the client-wide in-flight window is full. As in bulk
+     * mode the ticket is released per response from the poller threads.
+     */
+    void asyncSenderLoop() {
+        for (;;) {
+            RequestBatch batch;
+            if (!send_queue_.pop(batch)) {
+                break;
+            }
+
+            auto ticket = batch.ticket;
+            ticket->pending.fetch_add(batch.requests.size());
+
+            for (size_t i = 0; i < batch.requests.size(); ++i) {
+                size_t columns = batch.column_counts[i];
+                ingest_client_->IngestDataAsync(*batch.requests[i],
+                    [this, ticket, columns](const IngestDataResponse& response) {
+                        if (response.has_ackresult()) {
+                            stats_.signals_processed.fetch_add(columns);
+                        } else {
+                            ticket->failed.store(true);
+                        }
+                        releaseTicket(ticket);
+                    });
+            }
+
+            // Requests are serialized when the call starts, so the arena can go back now
+            batch.requests.clear();
+            batch.arena.reset();
+            releaseTicket(ticket);
+        }
+
+        ingest_client_->WaitForAsyncIdle();
+    }
+
+    void releaseTicket(const std::shared_ptr<FileTicket>& ticket) {
+        if (ticket->pending.fetch_sub(1) != 1) {
+            return;
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        updatePerformanceMetrics(std::chrono::duration<double>(end - ticket->start).count());
+
+        bool success = !ticket->failed.load();
+        if (success) {
+            stats_.files_processed.fetch_add(1);
+        } else {
+            stats_.files_failed.fetch_add(1);
+        }
+
+        if (on_file_complete_) {
+            on_file_complete_(ticket->filepath, success);
+        }
     }
 
     // Optimized signal name extraction
@@ -640,164 +1896,319 @@ private:
         return names;
     }
 
-    // Optimized ingestion request creation using new client structure
-    std::vector<IngestDataRequest> createIngestRequestsBatch(
+    // Optimized ingestion request creation using new client structure.
+    // Every message lives on the batch arena and is freed with it after sending.
+    // A signal goes out as one request per timestamp run, so files with gaps
+    // or glitches keep exact timestamps without falling back to a full list.
+    std::vector<IngestDataRequest*> createIngestRequestsBatch(
+        google::protobuf::Arena* arena,
         const std::vector<std::string>& signal_names,
-        const std::vector<std::vector<double>>& signal_data,
+        const std::vector<SignalBuffer>& signal_data,
         const std::vector<PvInfo>& pv_infos,
         const FileMetadata& file_metadata,
-        const std::vector<uint64_t>& timestamps,
-        const std::string& filepath) {
+        const PooledBuffer<uint64_t>& timestamps,
+        const std::vector<TimestampRun>& timestamp_runs,
+        const std::string& filepath,
+        std::vector<size_t>& column_counts) {
 
-        std::vector<IngestDataRequest> requests;
-        requests.reserve(signal_names.size());
+        std::vector<IngestDataRequest*> requests;
+        requests.reserve(signal_names.size() * timestamp_runs.size());
+        column_counts.reserve(signal_names.size() * timestamp_runs.size());
 
-        auto& common = data_processor_.getCommonClient();
+        for (size_t i = 0; i < signal_names.size(); ++i) {
+            appendSignalRequests(arena, i, signal_names, signal_data, pv_infos, file_metadata,
+                                 timestamps, timestamp_runs, filepath, requests, column_counts);
+        }
 
-        // Pre-calculate common metadata using CommonClient
-        uint64_t start_sec = timestamps.empty() ? 0 : timestamps[0];
-        uint64_t end_sec = timestamps.empty() ? 0 : timestamps.back();
-        uint64_t period_nanos = (timestamps.size() > 1) ?
-            ((timestamps[1] - timestamps[0]) * 1000000000ULL) : 1000000000ULL;
+        return requests;
+    }
 
-        // Create timestamps using CommonClient
-        auto start_ts = common.CreateTimestamp(start_sec, 0);
-        auto end_ts = common.CreateTimestamp(end_sec, 0);
+    // Requests for signal i alone, one per timestamp run (split to fit a frame)
+    void appendSignalRequests(
+        google::protobuf::Arena* arena,
+        size_t i,
+        const std::vector<std::string>& signal_names,
+        const std::vector<SignalBuffer>& signal_data,
+        const std::vector<PvInfo>& pv_infos,
+        const FileMetadata& file_metadata,
+        const PooledBuffer<uint64_t>& timestamps,
+        const std::vector<TimestampRun>& timestamp_runs,
+        const std::string& filepath,
+        std::vector<IngestDataRequest*>& requests,
+        std::vector<size_t>& column_counts) {
 
-        for (size_t i = 0; i < signal_names.size(); ++i) {
-            // Skip only if we couldn't allocate any data structure
-            if (signal_data[i].empty()) {
-                continue; // This means dataset couldn't be opened/allocated at all
-            }
+        auto& common = data_processor_.getCommonClient();
 
-            std::string requestId = "prod_" + std::to_string(file_counter_.fetch_add(1)) + 
-                                   "_" + std::to_string(std::time(nullptr));
+        // Skip only if we couldn't allocate any data structure
+        const size_t signal_samples = sampleCount(signal_data[i]);
+        if (signal_samples == 0) {
+            return; // This means dataset couldn't be opened/allocated at all
+        }
 
-            // Create attributes efficiently using CommonClient
-            std::vector<Attribute> attributes;
-            attributes.reserve(12);
+        // Runs larger than a frame go out as consecutive pieces, each its own request
+        const auto runs = TimestampSegmenter::Split(
+            signalRuns(signal_samples, timestamps, timestamp_runs),
+            maxSampleBytes(signal_data[i]), frameSampleBudget(max_frame_bytes_, signal_names[i].size()));
+        for (size_t r = 0; r < runs.size(); ++r) {
+            const TimestampRun& run = runs[r];
+            const uint64_t start_ns = timestamps[run.first];
+            const uint64_t end_ns = run.isRegular()
+                ? start_ns + (run.count - 1) * run.period_nanos
+                : timestamps[run.first + run.count - 1];
+            auto start_ts = common.CreateTimestamp(start_ns / 1000000000ULL, start_ns % 1000000000ULL);
+            auto end_ts = common.CreateTimestamp(end_ns / 1000000000ULL, end_ns % 1000000000ULL);
+
+            std::string requestId = "prod_" + std::to_string(file_counter_.fetch_add(1)) +
+                                   "_" + std::to_string(std::time(nullptr));
 
-            attributes.push_back(common.CreateAttribute("pv_name", signal_names[i]));
-            attributes.push_back(common.CreateAttribute("source_file", filepath));
-            attributes.push_back(common.CreateAttribute("sample_count", std::to_string(signal_data[i].size())));
-            attributes.push_back(common.CreateAttribute("beam_line", file_metadata.beam_line));
-            attributes.push_back(common.CreateAttribute("acquisition_date", file_metadata.date));
-            attributes.push_back(common.CreateAttribute("acquisition_time", file_metadata.time_id));
+            // Create the request envelope on the batch arena
+            IngestDataRequest* request = ingest_client_->CreateIngestRequest(arena, provider_id_, requestId);
+
+            // Attributes are allocated on the same arena and handed over without copying
+            auto* attributes = request->mutable_attributes();
+            attributes->Reserve(15);
+            auto addAttribute = [&](const std::string& name, const std::string& value) {
+                attributes->AddAllocated(common.CreateAttribute(arena, name, value));
+            };
+
+            addAttribute("pv_name", signal_names[i]);
+            addAttribute("source_file", filepath);
+            addAttribute("sample_count", std::to_string(run.count));
+            addAttribute("beam_line", file_metadata.beam_line);
+            addAttribute("acquisition_date", file_metadata.date);
+            addAttribute("acquisition_time", file_metadata.time_id);
+            if (runs.size() > 1) {
+                addAttribute("timestamp_run", std::to_string(r + 1) + "/" + std::to_string(runs.size()));
+            }
 
             // Add data quality metadata for scientific analysis
-            size_t nan_count = 0;
-            size_t inf_count = 0;
-            size_t valid_count = 0;
-
-            for (const auto& val : signal_data[i]) {
-                if (std::isnan(val)) {
-                    nan_count++;
-                } else if (std::isinf(val)) {
-                    inf_count++;
-                } else {
-                    valid_count++;
-                }
-            }
+            SampleStats quality = countQuality(signal_data[i], run.first, run.count);
+            const size_t nan_count = quality.nan;
+            const size_t inf_count = quality.inf;
+            const size_t valid_count = quality.valid;
 
-            attributes.push_back(common.CreateAttribute("valid_samples", std::to_string(valid_count)));
-            attributes.push_back(common.CreateAttribute("nan_samples", std::to_string(nan_count)));
-            attributes.push_back(common.CreateAttribute("inf_samples", std::to_string(inf_count)));
-            attributes.push_back(common.CreateAttribute("data_quality_ratio",
-                std::to_string(static_cast<double>(valid_count) / signal_data[i].size())));
+            addAttribute("valid_samples", std::to_string(valid_count));
+            addAttribute("nan_samples", std::to_string(nan_count));
+            addAttribute("inf_samples", std::to_string(inf_count));
+            addAttribute("data_quality_ratio",
+                std::to_string(static_cast<double>(valid_count) / run.count));
 
             if (pv_infos[i].valid) {
-                attributes.push_back(common.CreateAttribute("device_type", pv_infos[i].device_type));
-                attributes.push_back(common.CreateAttribute("device_area", pv_infos[i].device_area));
-                attributes.push_back(common.CreateAttribute("device_location", pv_infos[i].device_location));
-                attributes.push_back(common.CreateAttribute("measurement_type", pv_infos[i].measurement_type));
+                addAttribute("device_type", pv_infos[i].device_type);
+                addAttribute("device_area", pv_infos[i].device_area);
+                addAttribute("device_location", pv_infos[i].device_location);
+                addAttribute("measurement_type", pv_infos[i].measurement_type);
             }
 
-            std::vector<std::string> tags = {"h5_data", "accelerator_data", "production"};
+            request->add_tags("h5_data");
+            request->add_tags("accelerator_data");
+            request->add_tags("production");
 
             // Add data quality tags for downstream filtering
-            if (nan_count > 0) tags.push_back("contains_nan");
-            if (inf_count > 0) tags.push_back("contains_inf");
-            if (valid_count == signal_data[i].size()) tags.push_back("all_valid");
-
-            // Create event metadata using CommonClient
-            auto eventMetadata = common.CreateEventMetadata("H5: " + signal_names[i], start_ts, end_ts);
+            if (nan_count > 0) request->add_tags("contains_nan");
+            if (inf_count > 0) request->add_tags("contains_inf");
+            if (valid_count == run.count) request->add_tags("all_valid");
+
+            const bool sparse = useSparse(signal_data[i], quality, sparse_nan_);
+            if (sparse) request->add_tags("sparse_nan");
+
+            // Event metadata and the run's clock or timestamp list on the arena
+            request->set_allocated_eventmetadata(
+                common.CreateEventMetadata(arena, "H5: " + signal_names[i], start_ts, end_ts));
+            request->mutable_ingestiondataframe()->set_allocated_datatimestamps(
+                common.CreateDataTimestampsForRun(arena, timestamps.data(), run));
+
+            // Encode the column straight to wire bytes (dense columns keep NaN and Inf bit patterns)
+            auto dataColumn = encodeColumn(signal_names[i], signal_data[i], run.first, run.count, sparse);
+            IngestionClient::AttachSerializedColumns(*request, {dataColumn});
+
+            requests.push_back(request);
+            // The signal counts once, against its first run
+            column_counts.push_back(r == 0 ? 1 : 0);
+        }
+    }
 
-            // Create sampling clock using CommonClient
-            auto samplingClock = common.CreateSamplingClock(start_ts, period_nanos, 
-                                                           static_cast<uint32_t>(signal_data[i].size()));
+    /**
+     * Frame-packing variant of createIngestRequestsBatch. All signals of a file
+     * share the file's timestamps, so they go out up to pack_columns_ at a time
+     * under a single clock (or timestamp list) per run, event and tag set.
+     * Per-PV attributes and quality counts stay on the frame, prefixed with
+     * their PV (see packedColumnAttributes); data quality tags cover the
+     * whole frame.
+     */
+    std::vector<IngestDataRequest*> createPackedIngestRequests(
+        google::protobuf::Arena* arena,
+        const std::vector<std::string>& signal_names,
+        const std::vector<SignalBuffer>& signal_data,
+        const std::vector<PvInfo>& pv_infos,
+        const FileMetadata& file_metadata,
+        const PooledBuffer<uint64_t>& timestamps,
+        const std::vector<TimestampRun>& timestamp_runs,
+        const std::string& filepath,
+        std::vector<size_t>& column_counts) {
 
-            // NaN-preserving data value creation using CommonClient
-            std::vector<DataValue> dataValues;
-            dataValues.reserve(signal_data[i].size());
+        std::vector<IngestDataRequest*> requests;
+        auto& common = data_processor_.getCommonClient();
 
-            for (const auto& value : signal_data[i]) {
-                // Preserve NaN, Inf, and normal values
-                dataValues.push_back(common.CreateDoubleValue(value));
+        std::vector<size_t> packed;      // Indices of the signals that share the frames
+        std::vector<size_t> mismatched;  // Other lengths, sent on their own clocks
+        size_t sample_count = 0;
+        for (size_t i = 0; i < signal_names.size(); ++i) {
+            const size_t signal_samples = sampleCount(signal_data[i]);
+            if (signal_samples == 0) {
+                continue;
             }
+            // Frames share one clock, so every column must have the same length.
+            // Purely defensive: the readers already drop signals whose length
+            // differs from the timestamps, but one that slips through is sent
+            // on its own rather than lost.
+            if (sample_count != 0 && signal_samples != sample_count) {
+                mismatched.push_back(i);
+                continue;
+            }
+            sample_count = signal_samples;
+            packed.push_back(i);
+        }
 
-            // Create data column using CommonClient
-            auto dataColumn = common.CreateDataColumn(signal_names[i], dataValues);
+        for (size_t i : mismatched) {
+            appendSignalRequests(arena, i, signal_names, signal_data, pv_infos, file_metadata,
+                                 timestamps, timestamp_runs, filepath, requests, column_counts);
+        }
 
-            // Create data frame using IngestionClient helper
-            auto timestamps_obj = common.CreateDataTimestampsFromClock(samplingClock);
-            auto dataFrame = ingest_client_->CreateDataFrame(timestamps_obj, {dataColumn});
+        if (packed.empty()) {
+            return requests;
+        }
 
-            // Create the complete request
-            IngestDataRequest request;
-            request.set_providerid(provider_id_);
-            request.set_clientrequestid(requestId);
-            
-            for (const auto& attr : attributes) {
-                *request.add_attributes() = attr;
-            }
-            
-            for (const auto& tag : tags) {
-                request.add_tags(tag);
+        // Cut runs so the largest single column still fits a frame; packing
+        // then groups columns under the same cap
+        size_t sample_bytes = 0;
+        size_t longest_name = 0;
+        for (size_t i : packed) {
+            sample_bytes = std::max(sample_bytes, maxSampleBytes(signal_data[i]));
+            longest_name = std::max(longest_name, signal_names[i].size());
+        }
+        const auto runs = TimestampSegmenter::Split(
+            signalRuns(sample_count, timestamps, timestamp_runs), sample_bytes,
+            frameSampleBudget(max_frame_bytes_, longest_name));
+        for (size_t r = 0; r < runs.size(); ++r) {
+            const TimestampRun& run = runs[r];
+            const uint64_t start_ns = timestamps[run.first];
+            const uint64_t end_ns = run.isRegular()
+                ? start_ns + (run.count - 1) * run.period_nanos
+                : timestamps[run.first + run.count - 1];
+            auto start_ts = common.CreateTimestamp(start_ns / 1000000000ULL, start_ns % 1000000000ULL);
+            auto end_ts = common.CreateTimestamp(end_ns / 1000000000ULL, end_ns % 1000000000ULL);
+
+            std::vector<SerializedDataColumn> columns;
+            std::vector<std::pair<bool, bool>> column_quality;  // {has_nan, has_inf}
+            std::vector<AttributeList> column_attributes;
+            size_t column_attribute_bytes = 0;                  // Largest per-column share
+            columns.reserve(packed.size());
+            column_quality.reserve(packed.size());
+            column_attributes.reserve(packed.size());
+            for (size_t i : packed) {
+                SampleStats quality = countQuality(signal_data[i], run.first, run.count);
+                columns.push_back(encodeColumn(signal_names[i], signal_data[i], run.first, run.count,
+                                               useSparse(signal_data[i], quality, sparse_nan_)));
+                column_quality.emplace_back(quality.nan > 0, quality.inf > 0);
+                column_attributes.push_back(
+                    packedColumnAttributes(signal_names[i], pv_infos[i], quality, run.count));
+                column_attribute_bytes = std::max(column_attribute_bytes, attributeBytes(column_attributes.back()));
             }
-            
-            *request.mutable_eventmetadata() = eventMetadata;
-            *request.mutable_ingestiondataframe() = dataFrame;
 
-            requests.push_back(std::move(request));
+            // The PV attributes travel in the same message, so a full frame's
+            // share of them comes off the byte cap the columns are packed under
+            const size_t attribute_reserve = column_attribute_bytes * std::min(pack_columns_, packed.size());
+            auto frame_timestamps = common.CreateDataTimestampsForRun(timestamps.data(), run);
+            auto frames = ingest_client_->PackSerializedColumns(
+                frame_timestamps, std::move(columns), pack_columns_,
+                max_frame_bytes_ > attribute_reserve ? max_frame_bytes_ - attribute_reserve : 0);
+
+            auto eventMetadata = common.CreateEventMetadata("H5: " + file_metadata.filename, start_ts, end_ts);
+
+            size_t column_offset = 0;
+            for (auto& frame : frames) {
+                const size_t frame_first = column_offset;
+                const size_t frame_columns = frame.size();
+                bool any_nan = false, any_inf = false;
+                for (size_t c = frame_first; c < frame_first + frame_columns; ++c) {
+                    any_nan |= column_quality[c].first;
+                    any_inf |= column_quality[c].second;
+                }
+                column_offset += frame_columns;
+
+                IngestDataRequest* request = ingest_client_->CreateIngestRequest(
+                    arena, provider_id_,
+                    "prod_" + std::to_string(file_counter_.fetch_add(1)) + "_" + std::to_string(std::time(nullptr)));
+
+                auto* attributes = request->mutable_attributes();
+                attributes->AddAllocated(common.CreateAttribute(arena, "source_file", filepath));
+                attributes->AddAllocated(common.CreateAttribute(arena, "sample_count", std::to_string(run.count)));
+                attributes->AddAllocated(common.CreateAttribute(arena, "column_count", std::to_string(frame_columns)));
+                attributes->AddAllocated(common.CreateAttribute(arena, "beam_line", file_metadata.beam_line));
+                attributes->AddAllocated(common.CreateAttribute(arena, "acquisition_date", file_metadata.date));
+                attributes->AddAllocated(common.CreateAttribute(arena, "acquisition_time", file_metadata.time_id));
+                if (runs.size() > 1) {
+                    attributes->AddAllocated(common.CreateAttribute(arena, "timestamp_run",
+                        std::to_string(r + 1) + "/" + std::to_string(runs.size())));
+                }
+                for (size_t c = frame_first; c < frame_first + frame_columns; ++c) {
+                    for (const auto& [name, value] : column_attributes[c]) {
+                        attributes->AddAllocated(common.CreateAttribute(arena, name, value));
+                    }
+                }
+
+                request->add_tags("h5_data");
+                request->add_tags("accelerator_data");
+                request->add_tags("production");
+                request->add_tags("packed_frame");
+                if (any_nan) request->add_tags("contains_nan");
+                if (any_inf) request->add_tags("contains_inf");
+                if (!any_nan && !any_inf) request->add_tags("all_valid");
+
+                *request->mutable_eventmetadata() = eventMetadata;
+                *request->mutable_ingestiondataframe()->mutable_datatimestamps() = frame_timestamps;
+                IngestionClient::AttachSerializedColumns(*request, frame);
+
+                requests.push_back(request);
+                // Signals count once, against the frames of the first run
+                column_counts.push_back(r == 0 ? frame_columns : 0);
+            }
         }
 
         return requests;
     }
 
     // Production-grade ingestion with error handling
-    bool sendToIngestionOptimized(const std::vector<IngestDataRequest>& requests) {
+    bool sendToIngestionOptimized(const RequestBatch& batch) {
+        const auto& requests = batch.requests;
         if (!ingest_client_ || requests.empty()) {
             return false;
         }
 
         try {
-            std::lock_guard<std::mutex> lock(ingest_mutex_);
-
             const size_t OPTIMAL_BATCH = 24; // Conservative for production
+            bool all_acked = true;
 
             for (size_t i = 0; i < requests.size(); i += OPTIMAL_BATCH) {
                 size_t end_idx = std::min(i + OPTIMAL_BATCH, requests.size());
 
                 for (size_t j = i; j < end_idx; ++j) {
-                    auto response = ingest_client_->IngestDataWithResponse(
-                        requests[j].providerid(),
-                        requests[j].clientrequestid(),
-                        requests[j].ingestiondataframe(),
-                        std::vector<std::string>(requests[j].tags().begin(), requests[j].tags().end()),
-                        std::vector<Attribute>(requests[j].attributes().begin(), requests[j].attributes().end()),
-                        requests[j].has_eventmetadata() ? 
-                            std::optional<EventMetadata>(requests[j].eventmetadata()) : std::nullopt
-                    );
-                    
-                    // Check response if needed
-                    if (response.has_exceptionalresult()) {
-                        // Log error but continue processing
+                    // Sent as built so pre-encoded columns go out untouched
+                    auto response = ingest_client_->SendIngestRequest(*requests[j]);
+
+                    // A failed RPC also comes back as an exceptional result. The
+                    // rest of the batch is still sent, but the file fails so it
+                    // stays out of the resume cache and is retried
+                    if (!response.has_ackresult()) {
+                        all_acked = false;
                         continue;
                     }
+                    stats_.signals_processed.fetch_add(batch.column_counts[j]);
                 }
             }
 
-            return true;
+            return all_acked;
 
         } catch (const std::exception& e) {
             return false;
@@ -867,12 +2278,58 @@ public:
  */
 int main(int argc, char* argv[]) {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <directory> [--resume]" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <directory> [--resume] [--bulk | --async] [--window=N]"
+                  << " [--pack=K] [--max-frame-bytes=N] [--max-message-bytes=N] [--channels=N] [--least-outstanding]"
+                  << " [--double-columns] [--direct-chunks] [--no-mmap] [--sparse-nan]" << std::endl;
+        return 1;
+    }
+
+    ProcessorOptions options;
+    options.directory = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--resume") {
+            options.resume = true;
+        } else if (arg == "--bulk") {
+            options.bulk = true;
+        } else if (arg == "--async") {
+            options.async = true;
+        } else if (arg.rfind("--window=", 0) == 0) {
+            options.window = std::max<size_t>(1, std::strtoul(arg.c_str() + 9, nullptr, 10));
+        } else if (arg.rfind("--pack=", 0) == 0) {
+            options.pack_columns = std::max<size_t>(1, std::strtoul(arg.c_str() + 7, nullptr, 10));
+        } else if (arg.rfind("--max-frame-bytes=", 0) == 0) {
+            options.max_frame_bytes = std::max<size_t>(1, std::strtoull(arg.c_str() + 18, nullptr, 10));
+        } else if (arg.rfind("--max-message-bytes=", 0) == 0) {
+            options.max_message_bytes = std::max<size_t>(1024, std::strtoull(arg.c_str() + 20, nullptr, 10));
+        } else if (arg.rfind("--channels=", 0) == 0) {
+            options.channels = std::max<size_t>(1, std::strtoul(arg.c_str() + 11, nullptr, 10));
+        } else if (arg == "--least-outstanding") {
+            options.channel_policy = ChannelPool::Policy::LeastOutstanding;
+        } else if (arg == "--double-columns") {
+            options.native_types = false;
+        } else if (arg == "--direct-chunks") {
+            options.direct_chunks = true;
+        } else if (arg == "--no-mmap") {
+            options.memory_mapping = false;
+        } else if (arg == "--sparse-nan") {
+            options.sparse_nan = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (options.bulk && options.async) {
+        std::cerr << "--bulk and --async are mutually exclusive" << std::endl;
         return 1;
     }
+    if (options.max_frame_bytes == 0 || options.max_frame_bytes > options.max_message_bytes) {
+        options.max_frame_bytes = options.max_message_bytes -
+                                  options.max_message_bytes / FRAME_HEADROOM_DIVISOR;
+    }
 
-    std::string directory = argv[1];
-    bool resume = (argc > 2 && std::string(argv[2]) == "--resume");
+    const std::string& directory = options.directory;
+    bool resume = options.resume;
 
     try {
         std::cout << "PRODUCTION H5 Processor - Optimized for Non-Thread-Safe HDF5" << std::endl;
@@ -952,7 +2409,8 @@ int main(int argc, char* argv[]) {
         std::string provider_id;
 
         try {
-            ingest_client = std::make_unique<IngestionClient>("localhost:50051");
+            ingest_client = std::make_unique<IngestionClient>(
+                "localhost:50051", options.channels, options.channel_policy, options.max_message_bytes);
             
             auto& common = ingest_client->GetCommonClient();
             
@@ -979,65 +2437,91 @@ int main(int argc, char* argv[]) {
                 return 1;
             }
 
+            if (options.async) {
+                ingest_client->ConfigureAsync(ASYNC_POLLER_THREADS,
+                                              options.window ? options.window : DEFAULT_ASYNC_WINDOW);
+            }
+
         } catch (const std::exception& e) {
             std::cerr << "Failed to initialize gRPC client: " << e.what() << std::endl;
             return 1;
         }
 
         // Initialize production processor and thread pool
-        ProductionH5Processor processor(output_dir, ingest_client.get(), provider_id);
         ProcessingStats stats;
-        ProductionThreadPool thread_pool;
-
         std::atomic<size_t> completed_files{0};
-        std::atomic<bool> processing_complete{false};
+        TaskGroup files_in_flight;
+        files_in_flight.add(h5_files.size());
 
-        std::cout << "Processing " << h5_files.size() << " files with "
-                  << OPTIMAL_WORKER_THREADS << " worker threads..." << std::endl;
+        ProductionH5Processor processor(output_dir, ingest_client.get(), provider_id, stats, options);
+        WorkStealingScheduler scheduler(std::min(OPTIMAL_WORKER_THREADS,
+            std::max<size_t>(2, std::thread::hardware_concurrency())));
 
-        // Submit processing tasks with intelligent load balancing
-        for (const auto& filepath : h5_files) {
-            thread_pool.enqueue([&, filepath]() {
-                bool success = processor.processFile(filepath, stats);
-                if (success) {
-                    cache.markProcessed(filepath);
-                }
+        // Files complete asynchronously once their last batch has been sent
+        processor.setFileCompletionCallback([&](const std::string& filepath, bool success) {
+            if (success) {
+                cache.markProcessed(filepath);
+            }
 
-                size_t completed = completed_files.fetch_add(1) + 1;
-
-                // Progress reporting with production-appropriate frequency
-                if (completed % PROGRESS_INTERVAL == 0 || completed == h5_files.size()) {
-                    auto elapsed = std::chrono::steady_clock::now() - stats.start_time;
-                    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
-
-                    double completion_rate = static_cast<double>(completed) / h5_files.size() * 100.0;
-                    double files_per_second = seconds > 0 ? static_cast<double>(completed) / seconds : 0.0;
-                    double mb_per_second = seconds > 0 ?
-                        static_cast<double>(stats.bytes_processed.load()) / (1024*1024) / seconds : 0.0;
-                    double avg_time = processor.getAverageProcessingTime();
-
-                    std::cout << "\rProgress: " << completed << "/" << h5_files.size()
-                             << " (" << std::fixed << std::setprecision(1) << completion_rate << "%) "
-                             << "Rate: " << std::setprecision(1) << files_per_second << " files/s, "
-                             << mb_per_second << " MB/s "
-                             << "Avg: " << std::setprecision(3) << avg_time << "s/file "
-                             << "Signals: " << stats.signals_processed.load()
-                             << " Failed: " << stats.files_failed.load() << std::flush;
-                }
+            size_t completed = completed_files.fetch_add(1) + 1;
+
+            // Progress reporting with production-appropriate frequency
+            if (completed % PROGRESS_INTERVAL == 0 || completed == h5_files.size()) {
+                auto elapsed = std::chrono::steady_clock::now() - stats.start_time;
+                auto seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+
+                double completion_rate = static_cast<double>(completed) / h5_files.size() * 100.0;
+                double files_per_second = seconds > 0 ? static_cast<double>(completed) / seconds : 0.0;
+                double mb_per_second = seconds > 0 ?
+                    static_cast<double>(stats.bytes_processed.load()) / (1024*1024) / seconds : 0.0;
+                double avg_time = processor.getAverageProcessingTime();
+
+                std::cout << "\rProgress: " << completed << "/" << h5_files.size()
+                         << " (" << std::fixed << std::setprecision(1) << completion_rate << "%) "
+                         << "Rate: " << std::setprecision(1) << files_per_second << " files/s, "
+                         << mb_per_second << " MB/s "
+                         << "Avg: " << std::setprecision(3) << avg_time << "s/file "
+                         << "Signals: " << stats.signals_processed.load()
+                         << " Failed: " << stats.files_failed.load() << std::flush;
+            }
 
-                if (completed == h5_files.size()) {
-                    processing_complete.store(true);
-                }
-            });
+            files_in_flight.done();
+        });
+
+        std::cout << "Processing " << h5_files.size() << " files with "
+                  << OPTIMAL_WORKER_THREADS << " reader threads, " << BUILDER_THREADS
+                  << " builders, " << SENDER_THREADS << " senders";
+        if (options.bulk) {
+            std::cout << " (bulk streams, window "
+                      << (options.window ? options.window : DEFAULT_BULK_WINDOW) << ")";
+        } else if (options.async) {
+            std::cout << " (async, window "
+                      << (options.window ? options.window : DEFAULT_ASYNC_WINDOW) << ")";
         }
+        if (options.pack_columns > 1) {
+            std::cout << " (packing " << options.pack_columns << " signals/frame, "
+                      << options.max_frame_bytes / 1024 << " KB cap)";
+        }
+        if (options.channels > 1) {
+            std::cout << " (" << options.channels << " channels)";
+        }
+        if (options.direct_chunks) {
+            std::cout << " (direct chunk reads, " << ProductionH5Processor::decodeThreads()
+                      << " decode threads)";
+        }
+        std::cout << "..." << std::endl;
 
-        // Wait for completion with timeout safety
-        auto timeout = std::chrono::steady_clock::now() + std::chrono::hours(24); // 24 hour timeout
-        while (!processing_complete.load() && std::chrono::steady_clock::now() < timeout) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        // Submit reader-stage tasks; the HDF5 mutex keeps actual reads serialized
+        TaskGroup readers;
+        for (const auto& filepath : h5_files) {
+            scheduler.submit(readers, [&processor, filepath]() {
+                processor.processFile(filepath);
+            });
         }
+        scheduler.wait(readers);
 
-        if (!processing_complete.load()) {
+        // Files finish once their last send is acknowledged (24 hour safety timeout)
+        if (!files_in_flight.waitFor(std::chrono::hours(24))) {
             std::cerr << "\nProcessing timed out after 24 hours!" << std::endl;
             return 1;
         }
@@ -1059,6 +2543,28 @@ int main(int argc, char* argv[]) {
         std::cout << "Processing time: " << total_seconds << " seconds ("
                   << (total_seconds / 3600) << "h " << ((total_seconds % 3600) / 60) << "m)" << std::endl;
         std::cout << "Average file time: " << std::setprecision(3) << processor.getAverageProcessingTime() << " seconds" << std::endl;
+        std::cout << "Peak pipeline buffering: " << std::setprecision(1)
+                  << static_cast<double>(processor.getPeakQueuedBytes()) / (1024*1024) << " MB" << std::endl;
+        auto pool_stats = SignalBufferPool::instance().stats();
+        std::cout << "Signal buffer pool: " << pool_stats.hits << " reused, " << pool_stats.misses
+                  << " allocated, " << pool_stats.oversize << " oversize, peak "
+                  << static_cast<double>(pool_stats.peak_bytes) / (1024*1024) << " MB" << std::endl;
+        auto scheduler_stats = scheduler.stats();
+        std::cout << "Reader scheduler: " << scheduler_stats.tasks_run << " tasks, "
+                  << scheduler_stats.steals << " stolen, " << scheduler_stats.parks << " parks" << std::endl;
+        if (options.async) {
+            auto client_stats = ingest_client->GetStats();
+            std::cout << "Async calls: " << client_stats.async_calls
+                      << " (peak in flight " << client_stats.async_peak_in_flight << ")" << std::endl;
+        }
+        if (options.channels > 1) {
+            auto channel_stats = ingest_client->GetChannelStats();
+            for (size_t i = 0; i < channel_stats.size(); ++i) {
+                std::cout << "Channel " << i << ": " << channel_stats[i].calls << " calls, "
+                          << channel_stats[i].failures << " failed, peak outstanding "
+                          << channel_stats[i].peak_outstanding << std::endl;
+            }
+        }
 
         if (total_seconds > 0) {
             std::cout << "Throughput: " << std::setprecision(1)
@@ -1,5 +1,8 @@
+#include "parsers/h5_parser.hpp"
 #include "clients/ingest_client.hpp"
 #include "clients/common_client.hpp"
+#include "clients/column_encoder.hpp"
+#include "clients/sample_stats.hpp"
 #include <H5Cpp.h>
 #include <iostream>
 #include <filesystem>
@@ -14,6 +17,7 @@
 #include <atomic>
 #include <queue>
 #include <condition_variable>
+#include <cstdlib>
 #include <sys/times.h>
 #include <unistd.h>
 
@@ -21,6 +25,9 @@
 constexpr size_t WORKER_THREADS = 4;
 constexpr size_t BATCH_SIZE = 200;  // Sweet spot - 6x larger than original but not overwhelming
 constexpr size_t IO_BUFFER_SIZE = 4 * 1024 * 1024; // 4MB
+constexpr size_t DEFAULT_BULK_WINDOW = 64;          // In-flight requests on the bulk stream
+constexpr size_t FRAME_HEADROOM_DIVISOR = 8;       // Default frame cap leaves 1/8 of the message limit
+constexpr size_t FRAME_FIXED_BYTES = 256;           // Clock and column framing besides samples and name
 
 // Thread-safe HDF5 global mutex (critical for non-thread-safe HDF5)
 static std::mutex hdf5_global_mutex_;
@@ -80,6 +87,7 @@ struct Stats {
     std::atomic<size_t> files_processed{0};
     std::atomic<size_t> files_failed{0};
     std::atomic<size_t> signals_processed{0};
+    std::atomic<size_t> signals_failed{0};
     std::chrono::steady_clock::time_point start_time;
 
     Stats() : start_time(std::chrono::steady_clock::now()) {}
@@ -100,21 +108,13 @@ std::vector<double> readSignalData(H5::H5File& file, const std::string& signal_n
 
         data.resize(dims[0]);
 
-        // Try double first
+        // Read once as the stored type; NaN-fill if it is not numeric or fails
         try {
-            dataset.read(data.data(), H5::PredType::NATIVE_DOUBLE);
-        } catch (...) {
-            // Try float
-            try {
-                std::vector<float> float_data(dims[0]);
-                dataset.read(float_data.data(), H5::PredType::NATIVE_FLOAT);
-                for (size_t i = 0; i < dims[0]; i++) {
-                    data[i] = static_cast<double>(float_data[i]);
-                }
-            } catch (...) {
-                // Fill with NaN if all else fails
+            if (!H5NumericReader::read(dataset, data.data(), dims[0])) {
                 std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
             }
+        } catch (const H5::Exception&) {
+            std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
         }
 
         dataset.close();
@@ -127,7 +127,80 @@ std::vector<double> readSignalData(H5::H5File& file, const std::string& signal_n
     return data;
 }
 
-// Optimized timestamp reading
+// Direct chunk mode: copy the stored chunks of a compressed signal under the
+// HDF5 mutex. Null when the dataset does not qualify (see H5ChunkReader::fetch).
+std::unique_ptr<RawChunkedDataset> fetchCompressedSignal(H5::H5File& file, const std::string& signal_name) {
+    try {
+        H5::DataSet dataset = file.openDataSet(signal_name);
+        auto raw = std::make_unique<RawChunkedDataset>();
+        if (H5ChunkReader::fetch(dataset, *raw) && raw->sample_count <= 10000000) {
+            return raw;
+        }
+    } catch (...) {
+        // Fall back to readSignalData
+    }
+    return nullptr;
+}
+
+// Inflate a fetched signal into doubles without touching HDF5, so it runs
+// with the mutex released while other workers read. Corrupt chunks give
+// the same NaN-filled column as a failed read.
+std::vector<double> decodeCompressedSignal(const RawChunkedDataset& raw) {
+    std::vector<double> data;
+
+    try {
+        data.resize(raw.sample_count);
+        bool ok = true;
+        switch (raw.storage) {
+            case H5NumericReader::Storage::Float64:
+                ok = H5ChunkReader::decode(raw, data.data());
+                break;
+            case H5NumericReader::Storage::Float32: {
+                std::vector<float> native(raw.sample_count);
+                ok = H5ChunkReader::decode(raw, native.data());
+                H5NumericReader::widen(native.data(), data.data(), native.size());
+                break;
+            }
+            case H5NumericReader::Storage::Int32: {
+                std::vector<int32_t> native(raw.sample_count);
+                ok = H5ChunkReader::decode(raw, native.data());
+                H5NumericReader::widen(native.data(), data.data(), native.size());
+                break;
+            }
+            case H5NumericReader::Storage::Int64: {
+                std::vector<int64_t> native(raw.sample_count);
+                ok = H5ChunkReader::decode(raw, native.data());
+                std::copy(native.begin(), native.end(), data.begin());
+                break;
+            }
+            case H5NumericReader::Storage::UInt32: {
+                std::vector<uint32_t> native(raw.sample_count);
+                ok = H5ChunkReader::decode(raw, native.data());
+                std::copy(native.begin(), native.end(), data.begin());
+                break;
+            }
+            case H5NumericReader::Storage::UInt64: {
+                std::vector<uint64_t> native(raw.sample_count);
+                ok = H5ChunkReader::decode(raw, native.data());
+                std::copy(native.begin(), native.end(), data.begin());
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+        if (!ok) {
+            std::fill(data.begin(), data.end(), std::numeric_limits<double>::quiet_NaN());
+        }
+    } catch (...) {
+        data.clear();
+    }
+
+    return data;
+}
+
+// Optimized timestamp reading: nanoseconds since the epoch, from
+// secondsPastEpoch plus nanoseconds when the file has them
 std::vector<uint64_t> readTimestamps(H5::H5File& file) {
     std::vector<uint64_t> timestamps;
 
@@ -146,6 +219,22 @@ std::vector<uint64_t> readTimestamps(H5::H5File& file) {
 
             seconds_ds.close();
             space.close();
+
+            std::vector<uint64_t> nanoseconds;
+            if (!timestamps.empty() && file.nameExists("nanoseconds")) {
+                H5::DataSet nanos_ds = file.openDataSet("nanoseconds");
+                H5::DataSpace nanos_space = nanos_ds.getSpace();
+                hsize_t nanos_dims[1] = {0};
+                if (nanos_space.getSimpleExtentNdims() == 1) {
+                    nanos_space.getSimpleExtentDims(nanos_dims);
+                }
+                if (nanos_dims[0] == timestamps.size()) {
+                    nanoseconds.resize(nanos_dims[0]);
+                    nanos_ds.read(nanoseconds.data(), H5::PredType::NATIVE_UINT64);
+                }
+                nanos_ds.close();
+            }
+            timestamps = TimestampSegmenter::ToEpochNanos(timestamps, nanoseconds);
         }
     } catch (...) {
         timestamps.clear();
@@ -154,12 +243,81 @@ std::vector<uint64_t> readTimestamps(H5::H5File& file) {
     return timestamps;
 }
 
-// Process single H5 file with thread safety
+// Request ids must be unique across files so bulk acks can be matched back
+static std::atomic<uint64_t> request_sequence_{0};
+
+// How processed signals leave the app
+struct SendOptions {
+    IngestionClient::BulkIngestionSession* bulk_session = nullptr;  // null = unary RPCs
+    size_t pack_columns = 1;                                         // signals per frame
+    size_t max_frame_bytes = 0;                                      // 0 = 7/8 of the message limit
+    bool sparse_nan = false;                                         // sparse encoding for NaN columns
+};
+
+// Samples [first, first + count) as one column; with options.sparse_nan a
+// slice holding NaNs goes out in the sparse NaN encoding when that is smaller
+SerializedDataColumn encodeRun(const std::string& name, const std::vector<double>& values,
+                               size_t first, size_t count, const SendOptions& options) {
+    if (options.sparse_nan) {
+        SampleStats quality = SampleStatsKernel::Compute(values.data() + first, count);
+        if (quality.nan > 0 && ColumnEncoder::SparseIsSmaller(count, quality.nan, sizeof(double))) {
+            return ColumnEncoder::EncodeSparseSerializedColumn(name, values.data() + first, count);
+        }
+    }
+    return ColumnEncoder::EncodeSerializedColumn(name, values.data() + first, count);
+}
+
+// Send one frame of pre-encoded columns either over the shared bulk stream
+// (counted when acked) or as a unary call. Signals are counted per column so
+// packed frames tally correctly; a signal split over several timestamp runs
+// is counted with its first run only (counted = false for the others).
+void sendFrame(IngestionClient* client, const std::string& provider_id,
+               const std::string& request_id, const DataTimestamps& timestamps,
+               const std::vector<SerializedDataColumn>& frame_columns,
+               Stats& stats, const SendOptions& options, bool counted = true) {
+    size_t columns = counted ? frame_columns.size() : 0;
+
+    IngestDataRequest request;
+    request.set_providerid(provider_id);
+    request.set_clientrequestid(request_id);
+    request.add_tags("h5_data");
+    request.add_tags("optimized");
+    *request.mutable_ingestiondataframe()->mutable_datatimestamps() = timestamps;
+    IngestionClient::AttachSerializedColumns(request, frame_columns);
+
+    if (options.bulk_session) {
+        options.bulk_session->Send(request, [&stats, columns](const IngestDataResponse& response) {
+            if (response.has_ackresult()) {
+                stats.signals_processed += columns;
+            } else {
+                stats.signals_failed += columns;
+            }
+        });
+        return;
+    }
+
+    // Send single request using new client API
+    auto response = client->SendIngestRequest(request);
+
+    if (response.has_ackresult()) {
+        stats.signals_processed += columns;
+    } else {
+        stats.signals_failed += columns;
+    }
+}
+
+// Process single H5 file with thread safety. Timestamps are split into runs
+// (TimestampSegmenter) and every signal goes out once per run under the run's
+// SamplingClock or timestamp list. With frame packing, the signals of each
+// batch share those timestamps and go out as multi-column frames. With
+// direct_chunks, compressed signals are inflated with the HDF5 mutex released,
+// so the workers of the file pool decompress while another one reads.
 bool processFile(const std::string& filepath, const std::string& provider_id,
-                IngestionClient* client, Stats& stats) {
+                IngestionClient* client, Stats& stats, const SendOptions& options,
+                bool direct_chunks) {
     try {
         // CRITICAL: All HDF5 operations must be serialized
-        std::lock_guard<std::mutex> hdf5_lock(hdf5_global_mutex_);
+        std::unique_lock<std::mutex> hdf5_lock(hdf5_global_mutex_);
 
         H5::H5File file(filepath, H5F_ACC_RDONLY);
 
@@ -201,66 +359,102 @@ bool processFile(const std::string& filepath, const std::string& provider_id,
         // Get common client for helper functions
         auto& common = client->GetCommonClient();
 
-        // Calculate timing parameters using CommonClient
-        uint64_t start_sec = timestamps[0];
-        uint64_t period_nanos = (timestamps.size() > 1) ?
-            ((timestamps[1] - timestamps[0]) * 1000000000ULL) : 1000000000ULL;
-
-        // Validate period (100 Hz to 10 MHz range)
-        if (period_nanos < 100 || period_nanos > 10000000000ULL) {
-            period_nanos = 1000000000ULL; // 1 Hz fallback
-        }
-
-        // Create timestamps using CommonClient
-        auto start_ts = common.CreateTimestamp(start_sec, 0);
+        // Exact runs over the whole array; a signal of another length gets a
+        // single clock at the dominant period. Runs are then cut so a column
+        // with names up to name_length fits options.max_frame_bytes, and a
+        // large signal goes out as several time-contiguous requests.
+        const auto runs = TimestampSegmenter::Segment(timestamps.data(), timestamps.size());
+        const uint64_t dominant_period = TimestampSegmenter::DominantPeriod(runs);
+        auto runsFor = [&](size_t samples, size_t name_length) {
+            std::vector<TimestampRun> signal_runs = runs;
+            if (samples != timestamps.size()) {
+                signal_runs = {TimestampRun{0, samples, dominant_period ? dominant_period : 1000000000ULL, 1}};
+            }
+            size_t fixed = FRAME_FIXED_BYTES + name_length;
+            return TimestampSegmenter::Split(signal_runs, ColumnEncoder::MaxSampleBytes<double>(),
+                                             options.max_frame_bytes > fixed ? options.max_frame_bytes - fixed : 0);
+        };
 
         // Process signals in batches
         for (size_t batch_start = 0; batch_start < signal_names.size(); batch_start += BATCH_SIZE) {
             size_t batch_end = std::min(batch_start + BATCH_SIZE, signal_names.size());
 
+            // Signals waiting to be packed; they all share the same timestamps
+            std::vector<std::pair<std::string, std::vector<double>>> packed_signals;
+            size_t packed_samples = 0;
+
             for (size_t i = batch_start; i < batch_end; i++) {
                 const auto& signal_name = signal_names[i];
 
-                // Read signal data
-                auto values = readSignalData(file, signal_name);
+                // Read signal data; decoding never throws, so the file is
+                // never closed while the mutex is released
+                std::vector<double> values;
+                auto raw = direct_chunks ? fetchCompressedSignal(file, signal_name) : nullptr;
+                if (raw) {
+                    hdf5_lock.unlock();
+                    values = decodeCompressedSignal(*raw);
+                    raw.reset();
+                    hdf5_lock.lock();
+                } else {
+                    values = readSignalData(file, signal_name);
+                }
                 if (values.empty()) continue;
 
-                // Create request ID
-                std::string requestId = signal_name + "_" + std::to_string(i) + "_" +
-                                      std::to_string(std::time(nullptr));
-
-                // Create data values using CommonClient (preserving NaNs)
-                std::vector<DataValue> dataValues;
-                dataValues.reserve(values.size());
-                for (double value : values) {
-                    dataValues.push_back(common.CreateDoubleValue(value));
+                if (options.pack_columns > 1 &&
+                    (packed_samples == 0 || packed_samples == values.size())) {
+                    packed_samples = values.size();
+                    packed_signals.emplace_back(signal_name, std::move(values));
+                    continue;
                 }
 
-                // Create data column using CommonClient
-                auto dataColumn = common.CreateDataColumn(signal_name, dataValues);
+                const auto signal_runs = runsFor(values.size(), signal_name.size());
+                for (size_t r = 0; r < signal_runs.size(); ++r) {
+                    const TimestampRun& run = signal_runs[r];
+
+                    // Create request ID
+                    std::string requestId = signal_name + "_" + std::to_string(i) + "_" +
+                                          std::to_string(std::time(nullptr)) + "_" +
+                                          std::to_string(request_sequence_.fetch_add(1));
 
-                // Create sampling clock using CommonClient
-                auto samplingClock = common.CreateSamplingClock(
-                    start_ts, period_nanos, static_cast<uint32_t>(values.size()));
+                    // Encode the run's samples straight to wire bytes
+                    auto dataColumn = encodeRun(signal_name, values, run.first, run.count, options);
 
-                // Create data timestamps
-                auto dataTimestamps = common.CreateDataTimestampsFromClock(samplingClock);
+                    // Clock or timestamp list for the run using CommonClient
+                    auto dataTimestamps = common.CreateDataTimestampsForRun(timestamps.data(), run);
 
-                // Create ingestion data frame
-                auto dataFrame = client->CreateDataFrame(dataTimestamps, {dataColumn});
+                    sendFrame(client, provider_id, requestId, dataTimestamps, {dataColumn},
+                              stats, options, r == 0);
+                }
+            }
 
-                // Send single request using new client API
-                bool success = client->IngestData(
-                    provider_id,
-                    requestId,
-                    {dataColumn},
-                    dataTimestamps,
-                    {"h5_data", "optimized"},  // tags
-                    {}  // attributes
-                );
+            if (!packed_signals.empty()) {
+                size_t longest_name = 0;
+                for (const auto& signal : packed_signals) {
+                    longest_name = std::max(longest_name, signal.first.size());
+                }
+                const auto signal_runs = runsFor(packed_samples, longest_name);
+                for (size_t r = 0; r < signal_runs.size(); ++r) {
+                    const TimestampRun& run = signal_runs[r];
+
+                    std::vector<SerializedDataColumn> packed_columns;
+                    packed_columns.reserve(packed_signals.size());
+                    for (const auto& signal : packed_signals) {
+                        packed_columns.push_back(
+                            encodeRun(signal.first, signal.second, run.first, run.count, options));
+                    }
 
-                if (success) {
-                    stats.signals_processed++;
+                    auto dataTimestamps = common.CreateDataTimestampsForRun(timestamps.data(), run);
+                    auto frames = client->PackSerializedColumns(
+                        dataTimestamps, std::move(packed_columns),
+                        options.pack_columns, options.max_frame_bytes);
+
+                    for (auto& frame : frames) {
+                        std::string requestId = "packed_" + std::to_string(batch_start) + "_" +
+                                              std::to_string(std::time(nullptr)) + "_" +
+                                              std::to_string(request_sequence_.fetch_add(1));
+                        sendFrame(client, provider_id, requestId, dataTimestamps, frame,
+                                  stats, options, r == 0);
+                    }
                 }
             }
         }
@@ -321,21 +515,51 @@ std::vector<std::string> findH5Files(const std::string& root_directory) {
 
 int main(int argc, char* argv[]) {
     if (argc < 2) {
-        std::cout << "Usage: " << argv[0] << " <directory> [--collection-suffix=YYYY_MM]" << std::endl;
+        std::cout << "Usage: " << argv[0] << " <directory> [--collection-suffix=YYYY_MM] [--bulk] [--window=N]"
+                  << " [--pack=K] [--max-frame-bytes=N] [--max-message-bytes=N] [--channels=N] [--least-outstanding]"
+                  << " [--direct-chunks] [--sparse-nan]" << std::endl;
         std::cout << "Supports: Direct directory with .h5 files OR year/month/day structure" << std::endl;
         return 1;
     }
 
     std::string root_directory = argv[1];
     std::string collection_suffix = "";
+    bool bulk = false;
+    size_t bulk_window = DEFAULT_BULK_WINDOW;
+    size_t channels = 1;
+    ChannelPool::Policy channel_policy = ChannelPool::Policy::RoundRobin;
+    size_t max_message_bytes = ChannelPool::DEFAULT_MAX_MESSAGE_BYTES;
+    SendOptions send_options;
+    bool direct_chunks = false;
 
     // Parse command line arguments
     for (int i = 2; i < argc; ++i) {
         std::string arg = argv[i];
         if (arg.substr(0, 20) == "--collection-suffix=") {
             collection_suffix = arg.substr(20);
+        } else if (arg == "--bulk") {
+            bulk = true;
+        } else if (arg.rfind("--window=", 0) == 0) {
+            bulk_window = std::max<size_t>(1, std::strtoul(arg.c_str() + 9, nullptr, 10));
+        } else if (arg.rfind("--pack=", 0) == 0) {
+            send_options.pack_columns = std::max<size_t>(1, std::strtoul(arg.c_str() + 7, nullptr, 10));
+        } else if (arg.rfind("--max-frame-bytes=", 0) == 0) {
+            send_options.max_frame_bytes = std::max<size_t>(1, std::strtoull(arg.c_str() + 18, nullptr, 10));
+        } else if (arg.rfind("--max-message-bytes=", 0) == 0) {
+            max_message_bytes = std::max<size_t>(1024, std::strtoull(arg.c_str() + 20, nullptr, 10));
+        } else if (arg.rfind("--channels=", 0) == 0) {
+            channels = std::max<size_t>(1, std::strtoul(arg.c_str() + 11, nullptr, 10));
+        } else if (arg == "--least-outstanding") {
+            channel_policy = ChannelPool::Policy::LeastOutstanding;
+        } else if (arg == "--direct-chunks") {
+            direct_chunks = true;
+        } else if (arg == "--sparse-nan") {
+            send_options.sparse_nan = true;
         }
     }
+    if (send_options.max_frame_bytes == 0 || send_options.max_frame_bytes > max_message_bytes) {
+        send_options.max_frame_bytes = max_message_bytes - max_message_bytes / FRAME_HEADROOM_DIVISOR;
+    }
 
     // Capture start times for detailed timing
     auto wall_start = std::chrono::high_resolution_clock::now();
@@ -350,8 +574,9 @@ int main(int argc, char* argv[]) {
         ss << "ingest_data_optimized_" << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S");
         std::string provider_name = ss.str();
 
-        // Setup client using new structure
-        IngestionClient client("localhost:50051");
+        // Setup client using new structure; with --channels=N workers spread
+        // their RPCs over N separate connections
+        IngestionClient client("localhost:50051", channels, channel_policy, max_message_bytes);
         auto& common = client.GetCommonClient();
 
         std::vector<Attribute> attrs;
@@ -396,11 +621,33 @@ int main(int argc, char* argv[]) {
         SimpleThreadPool thread_pool;
         std::atomic<size_t> completed{0};
 
-        std::cout << "Processing with " << WORKER_THREADS << " threads..." << std::endl;
+        // Bulk mode shares one long-lived stream; Send() is thread-safe and only
+        // blocks when the in-flight window is full
+        std::unique_ptr<IngestionClient::BulkIngestionSession> bulk_session;
+        if (bulk) {
+            bulk_session = client.CreateBulkIngestionSession(bulk_window);
+            std::cout << "Bulk streaming enabled (window " << bulk_window << ")" << std::endl;
+        }
+        send_options.bulk_session = bulk_session.get();
+        if (send_options.pack_columns > 1) {
+            std::cout << "Packing up to " << send_options.pack_columns << " signals per frame ("
+                      << send_options.max_frame_bytes / 1024 << " KB cap)" << std::endl;
+        }
+
+        std::cout << "Processing with " << WORKER_THREADS << " threads";
+        if (channels > 1) {
+            std::cout << " over " << channels << " channels ("
+                      << (channel_policy == ChannelPool::Policy::LeastOutstanding ? "least outstanding" : "round robin")
+                      << ")";
+        }
+        if (direct_chunks) {
+            std::cout << " (direct chunk reads)";
+        }
+        std::cout << "..." << std::endl;
 
         for (const auto& filepath : h5_files) {
             thread_pool.enqueue([&, filepath]() {
-                processFile(filepath, provider_id.value(), &client, stats);
+                processFile(filepath, provider_id.value(), &client, stats, send_options, direct_chunks);
 
                 size_t count = completed.fetch_add(1) + 1;
 
@@ -424,6 +671,28 @@ int main(int argc, char* argv[]) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
 
+        // Wait for the outstanding acks before reporting
+        if (bulk_session) {
+            if (!bulk_session->Finish()) {
+                std::cerr << "\nBulk stream finished with errors: " << bulk_session->GetLastError() << std::endl;
+            }
+            auto bulk_stats = bulk_session->GetStats();
+            std::cout << "\nBulk stream: " << bulk_stats.requests_sent << " sent, "
+                      << bulk_stats.requests_acked << " acked, "
+                      << bulk_stats.requests_rejected + bulk_stats.requests_failed << " failed, peak in flight "
+                      << bulk_stats.peak_in_flight << std::endl;
+        }
+
+        if (channels > 1) {
+            auto channel_stats = client.GetChannelStats();
+            for (size_t i = 0; i < channel_stats.size(); ++i) {
+                std::cout << "\nChannel " << i << ": " << channel_stats[i].calls << " calls, "
+                          << channel_stats[i].failures << " failed, peak outstanding "
+                          << channel_stats[i].peak_outstanding;
+            }
+            std::cout << std::endl;
+        }
+
         // Final stats with detailed timing
         auto wall_end = std::chrono::high_resolution_clock::now();
         struct tms tms_end;
@@ -442,6 +711,9 @@ int main(int argc, char* argv[]) {
         std::cout << "Files processed: " << stats.files_processed.load() << std::endl;
         std::cout << "Files failed: " << stats.files_failed.load() << std::endl;
         std::cout << "Total signals: " << stats.signals_processed.load() << std::endl;
+        if (stats.signals_failed.load() > 0) {
+            std::cout << "Signals failed: " << stats.signals_failed.load() << std::endl;
+        }
         std::cout << "Processing time: " << total_seconds << " seconds" << std::endl;
 
         if (total_seconds > 0) {
@@ -0,0 +1,239 @@
+/**
+ * Micro-benchmark for NameTokenizer against the std::regex parsing it
+ * replaced in H5Parser (file names and signal names) and the
+ * istringstream/vector splitting used for PV names.
+ *
+ * Every name of a generated corpus is parsed both ways first and the
+ * results compared, so the timings are only reported for equivalent output.
+ *
+ * Usage: ./name_tokenizer_bench [iterations]
+ */
+
+#include "parsers/name_tokenizer.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ========== Reference Implementations ==========
+
+// As H5Parser::parseFilename did it: a fresh regex per call
+bool regexFilename(const std::string& filepath, std::string (&out)[5]) {
+    std::string filename = std::filesystem::path(filepath).stem().string();
+    std::regex pattern(R"(([A-Z]+)_([A-Z]+)_(\d{8})_(\d{6})(?:_([A-Za-z0-9]+))?)");
+    std::smatch matches;
+    if (!std::regex_match(filename, matches, pattern)) {
+        return false;
+    }
+    for (int i = 0; i < 5; ++i) {
+        out[i] = matches[i + 1].matched ? matches[i + 1].str() : std::string();
+    }
+    return true;
+}
+
+// As H5Parser::parseSignalName did it
+bool regexSignalName(const std::string& name, std::string (&out)[4]) {
+    std::regex pattern(R"(([A-Z]+)_([A-Z0-9]+)_(\d+)_([A-Z0-9_]+))");
+    std::smatch matches;
+    if (!std::regex_match(name, matches, pattern)) {
+        return false;
+    }
+    for (int i = 0; i < 4; ++i) {
+        out[i] = matches[i + 1].str();
+    }
+    return true;
+}
+
+// As convertArchiverToSignalData did it
+size_t streamSplit(const std::string& pv_name, std::string (&out)[4]) {
+    std::vector<std::string> parts;
+    std::istringstream ss(pv_name);
+    std::string part;
+    while (std::getline(ss, part, ':')) {
+        parts.push_back(part);
+    }
+    for (size_t i = 0; i < 4 && i < parts.size(); ++i) {
+        out[i] = parts[i];
+    }
+    return parts.size();
+}
+
+// ========== Corpus ==========
+
+struct Corpus {
+    std::vector<std::string> filenames;
+    std::vector<std::string> signal_names;
+    std::vector<std::string> pv_names;
+};
+
+Corpus makeCorpus(size_t count) {
+    static const char* devices[] = {"KLYS", "BPMS", "QUAD", "XCOR", "TORO", "GDET"};
+    static const char* areas[] = {"LI23", "DMPH", "LTUH", "UND1", "IN20", "BSYH"};
+    static const char* attributes[] = {"AMPL", "TMITBR", "PHAS_FASTBR", "X", "BACT", "ENRC_1"};
+
+    std::mt19937 rng(42);
+    Corpus corpus;
+    for (size_t i = 0; i < count; ++i) {
+        const char* device = devices[rng() % 6];
+        const char* area = areas[rng() % 6];
+        const char* attribute = attributes[rng() % 6];
+        std::string location = std::to_string(rng() % 1000);
+
+        std::string signal = std::string(device) + "_" + area + "_" + location + "_" + attribute;
+        std::string pv = std::string(device) + ":" + area + ":" + location + ":" + attribute;
+        std::string file = "/data/run/CU_HXR_2025" + std::to_string(1000 + rng() % 9000) +
+                           "_" + std::to_string(100000 + rng() % 900000) +
+                           (rng() % 2 ? "_CoAD" : "") + ".h5";
+
+        // Sprinkle in names that must not match
+        switch (rng() % 10) {
+            case 0: signal[rng() % signal.size()] = 'x'; break;
+            case 1: signal += "_"; pv += ":"; break;
+            case 2: file.insert(file.size() - 3, "_"); break;
+            case 3: file[file.find("HXR")] = 'h'; pv = pv.substr(0, pv.rfind(':')); break;
+            default: break;
+        }
+
+        corpus.filenames.push_back(file);
+        corpus.signal_names.push_back(signal);
+        corpus.pv_names.push_back(pv);
+    }
+    return corpus;
+}
+
+// ========== Equivalence ==========
+
+size_t countMismatches(const Corpus& corpus) {
+    size_t mismatches = 0;
+
+    for (const auto& file : corpus.filenames) {
+        std::string expected[5];
+        bool expected_ok = regexFilename(file, expected);
+        NameTokenizer::FilenameTokens tokens;
+        bool ok = NameTokenizer::ParseFilename(NameTokenizer::Stem(file), tokens);
+        if (ok != expected_ok ||
+            (ok && (tokens.origin != expected[0] || tokens.pathway != expected[1] ||
+                    tokens.date != expected[2] || tokens.time != expected[3] ||
+                    tokens.project != expected[4]))) {
+            mismatches++;
+        }
+    }
+
+    for (const auto& name : corpus.signal_names) {
+        std::string expected[4];
+        bool expected_ok = regexSignalName(name, expected);
+        NameTokenizer::SignalNameTokens tokens;
+        bool ok = NameTokenizer::ParseSignalName(name, tokens);
+        if (ok != expected_ok ||
+            (ok && (tokens.device != expected[0] || tokens.area != expected[1] ||
+                    tokens.location != expected[2] || tokens.attribute != expected[3]))) {
+            mismatches++;
+        }
+    }
+
+    for (const auto& pv : corpus.pv_names) {
+        std::string expected[4];
+        size_t expected_count = std::min<size_t>(streamSplit(pv, expected), 4);
+        std::string_view fields[4];
+        size_t count = NameTokenizer::Split(pv, ':', fields, 4);
+        bool same = count == expected_count;
+        for (size_t i = 0; same && i < count; ++i) {
+            same = fields[i] == expected[i];
+        }
+        mismatches += same ? 0 : 1;
+    }
+
+    return mismatches;
+}
+
+// ========== Timing ==========
+
+template<typename F>
+double nanosPerName(size_t iterations, size_t names, F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        body();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(iterations * names);
+}
+
+void report(const char* what, double before, double after) {
+    std::cout << std::left << std::setw(14) << what << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << before << " ns" << std::setw(12) << after << " ns"
+              << std::setw(10) << (before / after) << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t iterations = argc > 1 ? std::max<size_t>(1, std::strtoul(argv[1], nullptr, 10)) : 20;
+    const size_t NAMES = 10000;
+
+    Corpus corpus = makeCorpus(NAMES);
+
+    size_t mismatches = countMismatches(corpus);
+    if (mismatches != 0) {
+        std::cerr << mismatches << " names parsed differently by NameTokenizer" << std::endl;
+        return 1;
+    }
+
+    // Keeps the optimizer from dropping the parsing work
+    size_t sink = 0;
+
+    double file_before = nanosPerName(iterations, NAMES, [&] {
+        for (const auto& file : corpus.filenames) {
+            std::string out[5];
+            sink += regexFilename(file, out);
+        }
+    });
+    double file_after = nanosPerName(iterations, NAMES, [&] {
+        for (const auto& file : corpus.filenames) {
+            NameTokenizer::FilenameTokens tokens;
+            sink += NameTokenizer::ParseFilename(NameTokenizer::Stem(file), tokens);
+        }
+    });
+
+    double signal_before = nanosPerName(iterations, NAMES, [&] {
+        for (const auto& name : corpus.signal_names) {
+            std::string out[4];
+            sink += regexSignalName(name, out);
+        }
+    });
+    double signal_after = nanosPerName(iterations, NAMES, [&] {
+        for (const auto& name : corpus.signal_names) {
+            NameTokenizer::SignalNameTokens tokens;
+            sink += NameTokenizer::ParseSignalName(name, tokens);
+        }
+    });
+
+    double pv_before = nanosPerName(iterations, NAMES, [&] {
+        for (const auto& pv : corpus.pv_names) {
+            std::string out[4];
+            sink += streamSplit(pv, out);
+        }
+    });
+    double pv_after = nanosPerName(iterations, NAMES, [&] {
+        for (const auto& pv : corpus.pv_names) {
+            std::string_view fields[4];
+            sink += NameTokenizer::Split(pv, ':', fields, 4);
+        }
+    });
+
+    std::cout << NAMES << " names x " << iterations << " iterations, all results identical" << std::endl;
+    std::cout << std::left << std::setw(14) << "" << std::right << std::setw(15) << "before"
+              << std::setw(15) << "after" << std::setw(11) << "speedup" << std::endl;
+    report("file names", file_before, file_after);
+    report("signal names", signal_before, signal_after);
+    report("PV names", pv_before, pv_after);
+
+    return sink == 0 ? 1 : 0;
+}
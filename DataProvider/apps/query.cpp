@@ -1,4 +1,5 @@
 #include "query_client.hpp"
+#include "sample_stats.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
@@ -110,40 +111,47 @@ struct Statistics {
     double max_val = 0.0;
     size_t count = 0;
     size_t nan_count = 0;
+    size_t inf_count = 0;
 };
 
+// Counts, extremes and the mean come from one SampleStatsKernel pass. The
+// finite values are then gathered for an exact two-pass variance (the
+// kernel's sum of squares cancels badly on large, slowly varying values) and
+// for the median, found by selection rather than a sort.
+// Inf samples are reported separately and not counted as valid.
 Statistics calculateStatistics(const std::vector<double>& values) {
     Statistics stats;
-    std::vector<double> valid_values;
-    
-    for (double val : values) {
-        if (std::isnan(val)) {
-            stats.nan_count++;
-        } else {
-            valid_values.push_back(val);
-        }
-    }
+    SampleStats sample_stats = SampleStatsKernel::Compute(values.data(), values.size());
     
-    stats.count = valid_values.size();
+    stats.nan_count = sample_stats.nan;
+    stats.inf_count = sample_stats.inf;
+    stats.count = sample_stats.valid;
     if (stats.count == 0) return stats;
     
-    stats.mean = std::accumulate(valid_values.begin(), valid_values.end(), 0.0) / stats.count;
-    
-    auto minmax = std::minmax_element(valid_values.begin(), valid_values.end());
-    stats.min_val = *minmax.first;
-    stats.max_val = *minmax.second;
+    stats.mean = sample_stats.mean();
+    stats.min_val = sample_stats.min;
+    stats.max_val = sample_stats.max;
     
-    std::vector<double> sorted = valid_values;
-    std::sort(sorted.begin(), sorted.end());
-    size_t mid = sorted.size() / 2;
-    stats.median = (sorted.size() % 2 == 0) ? 
-        (sorted[mid-1] + sorted[mid]) / 2.0 : sorted[mid];
+    std::vector<double> valid_values;
+    valid_values.reserve(stats.count);
+    for (size_t i = sample_stats.first_valid; i <= sample_stats.last_valid; ++i) {
+        if (std::isfinite(values[i])) {
+            valid_values.push_back(values[i]);
+        }
+    }
     
     double variance = 0.0;
     for (double val : valid_values) {
         variance += (val - stats.mean) * (val - stats.mean);
     }
     stats.std_dev = std::sqrt(variance / stats.count);
+    size_t mid = valid_values.size() / 2;
+    std::nth_element(valid_values.begin(), valid_values.begin() + mid, valid_values.end());
+    stats.median = valid_values[mid];
+    if (valid_values.size() % 2 == 0) {
+        double lower = *std::max_element(valid_values.begin(), valid_values.begin() + mid);
+        stats.median = (lower + stats.median) / 2.0;
+    }
     
     return stats;
 }
@@ -241,6 +249,9 @@ void executeStatistics(QueryClient& client, const Config& config) {
         if (stats.nan_count > 0) {
             std::cout << "  NaNs: " << stats.nan_count << std::endl;
         }
+        if (stats.inf_count > 0) {
+            std::cout << "  Infs: " << stats.inf_count << std::endl;
+        }
         std::cout << "  Mean: " << std::fixed << std::setprecision(6) << stats.mean << std::endl;
         std::cout << "  Median: " << stats.median << std::endl;
         std::cout << "  Std Dev: " << stats.std_dev << std::endl;
@@ -0,0 +1,114 @@
+#ifndef CHANNEL_POOL_HPP
+#define CHANNEL_POOL_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <grpcpp/grpcpp.h>
+
+/**
+ * A fixed set of gRPC channels to one server, each on its own HTTP/2
+ * connection. A single channel multiplexes every call over one TCP flow and
+ * one flow-control window; spreading calls across several channels lets
+ * throughput scale with the number of concurrent callers.
+ *
+ * Callers Acquire() a channel index before a call and Release() it when the
+ * call completes. Release is what drives the outstanding counts used by
+ * least-outstanding selection and the per-channel statistics.
+ */
+class ChannelPool {
+public:
+    enum class Policy {
+        RoundRobin,        // Rotate through the channels
+        LeastOutstanding   // Pick the channel with the fewest unfinished calls
+    };
+
+    struct ChannelStats {
+        uint64_t calls = 0;
+        uint64_t failures = 0;
+        size_t outstanding = 0;
+        size_t peak_outstanding = 0;
+        grpc_connectivity_state state = GRPC_CHANNEL_IDLE;
+    };
+
+    // gRPC refuses messages over 4 MB on the receiving side unless told
+    // otherwise; channels opened by the pool use this as their send and
+    // receive limit
+    static constexpr size_t DEFAULT_MAX_MESSAGE_BYTES = 4 * 1024 * 1024;
+
+    // Open channel_count insecure channels to server_address. Messages over
+    // max_message_bytes fail locally instead of being sent.
+    ChannelPool(const std::string& server_address, size_t channel_count,
+                Policy policy = Policy::RoundRobin,
+                size_t max_message_bytes = DEFAULT_MAX_MESSAGE_BYTES);
+
+    // Wrap an existing channel as a pool of one
+    explicit ChannelPool(std::shared_ptr<grpc::Channel> channel);
+
+    ~ChannelPool();
+
+    ChannelPool(const ChannelPool&) = delete;
+    ChannelPool& operator=(const ChannelPool&) = delete;
+
+    size_t Size() const;
+    Policy GetPolicy() const;
+    // Limit the channels were opened with; 0 for a wrapped channel (unknown)
+    size_t GetMaxMessageBytes() const;
+    std::shared_ptr<grpc::Channel> GetChannel(size_t index) const;
+
+    // Choose a channel for one call and count it as outstanding
+    size_t Acquire();
+
+    // Finish a call started with Acquire()
+    void Release(size_t index, bool ok);
+
+    // Scoped Acquire()/Release() for blocking calls. The call counts as
+    // failed unless MarkOk() is called before the lease goes away.
+    class Lease {
+    public:
+        explicit Lease(ChannelPool& pool) : pool_(pool), index_(pool.Acquire()) {}
+        ~Lease() { pool_.Release(index_, ok_); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        size_t Index() const { return index_; }
+        void MarkOk(bool ok = true) { ok_ = ok; }
+
+    private:
+        ChannelPool& pool_;
+        size_t index_;
+        bool ok_ = false;
+    };
+
+    // True when at least one channel is READY
+    bool IsConnected() const;
+
+    // Best state across the channels (READY beats CONNECTING beats the rest)
+    grpc_connectivity_state GetState(bool try_to_connect) const;
+
+    // Wait until every channel is connected or the deadline passes
+    bool WaitForConnected(std::chrono::system_clock::time_point deadline);
+
+    std::vector<ChannelStats> GetStats() const;
+    void ResetStats();
+
+private:
+    struct Slot {
+        std::shared_ptr<grpc::Channel> channel;
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<size_t> outstanding{0};
+        std::atomic<size_t> peak_outstanding{0};
+    };
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+    Policy policy_;
+    size_t max_message_bytes_ = 0;
+    std::atomic<size_t> next_{0};
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef COLUMN_ENCODER_HPP
+#define COLUMN_ENCODER_HPP
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "common_client.hpp"
+
+/**
+ * Writes the protobuf wire bytes of a DataColumn directly from a block of
+ * samples, skipping the per-sample DataValue objects that the
+ * CommonClient::CreateDoubleValue -> CreateDataColumn path allocates and
+ * copies several times over.
+ *
+ * The output is byte-for-byte what DataColumn::SerializeAsString() produces
+ * for the same column, so it can be parsed back into a DataColumn, wrapped in
+ * a SerializedDataColumn, or spliced into a request with
+ * IngestionClient::AttachSerializedColumns().
+ */
+class ColumnEncoder {
+public:
+    // Exact encoded size of a double column, useful for reserving buffers and
+    // for frame size budgets
+    static size_t EncodedDoubleColumnSize(size_t name_length, size_t count);
+
+    // Append the DataColumn encoding of `values` to `out`
+    static void AppendDoubleColumn(std::string& out, const std::string& name,
+                                   const double* values, size_t count);
+
+    // DataColumn wire bytes as a standalone string
+    static std::string EncodeDoubleColumn(const std::string& name,
+                                          const double* values, size_t count);
+
+    // Same bytes wrapped in the SerializedDataColumn message from common.proto
+    static SerializedDataColumn EncodeSerializedColumn(const std::string& name,
+                                                       const double* values, size_t count);
+
+    // ========== Typed Columns ==========
+    // Columns of the other numeric DataValue cases, so samples keep the type
+    // they were stored with: floatValue (7 bytes per sample against 11 for a
+    // double), intValue/longValue (zigzag varints) and uintValue/ulongValue
+    // (varints).
+    static size_t EncodedFloatColumnSize(size_t name_length, size_t count);
+
+    static void AppendFloatColumn(std::string& out, const std::string& name,
+                                  const float* values, size_t count);
+    static void AppendIntColumn(std::string& out, const std::string& name,
+                                const int32_t* values, size_t count);
+    static void AppendLongColumn(std::string& out, const std::string& name,
+                                 const int64_t* values, size_t count);
+    static void AppendUIntColumn(std::string& out, const std::string& name,
+                                 const uint32_t* values, size_t count);
+    static void AppendULongColumn(std::string& out, const std::string& name,
+                                  const uint64_t* values, size_t count);
+
+    // Upper bound on what one sample adds to a dense column of T: the
+    // DataValue's tag and length byte, the value's tag, and the value. Sparse
+    // columns only ever come out smaller.
+    template<typename T>
+    static constexpr size_t MaxSampleBytes() {
+        if constexpr (std::is_same_v<T, double>) {
+            return 3 + 8;
+        } else if constexpr (std::is_same_v<T, float>) {
+            return 3 + 4;
+        } else {
+            return 3 + 10;  // Varint
+        }
+    }
+
+    static SerializedDataColumn EncodeSerializedColumn(const std::string& name,
+                                                       const float* values, size_t count);
+    static SerializedDataColumn EncodeSerializedColumn(const std::string& name,
+                                                       const int32_t* values, size_t count);
+    static SerializedDataColumn EncodeSerializedColumn(const std::string& name,
+                                                       const int64_t* values, size_t count);
+    static SerializedDataColumn EncodeSerializedColumn(const std::string& name,
+                                                       const uint32_t* values, size_t count);
+    static SerializedDataColumn EncodeSerializedColumn(const std::string& name,
+                                                       const uint64_t* values, size_t count);
+
+    // ========== Sparse Columns ==========
+    // Mostly-NaN float and double signals can go out as one DataValue whose
+    // structureValue has these fields, in this order:
+    //
+    //   encoding   stringValue     SPARSE_ENCODING
+    //   count      ulongValue      samples in the dense column
+    //   valueType  stringValue     "double" or "float"
+    //   validity   byteArrayValue  ceil(count / 8) bytes; bit i % 8 of byte
+    //                              i / 8 is set when sample i is not NaN
+    //   values     byteArrayValue  the non-NaN samples in order, as
+    //                              little-endian IEEE 754 (8 or 4 bytes each)
+    //
+    // Inf samples are kept as values. NaN samples come back as quiet NaNs, so
+    // NaN payload bits are not preserved. At 95% NaN a double column takes
+    // about half a byte per sample instead of 11.
+    static constexpr const char* SPARSE_ENCODING = "sparse_nan_v1";
+
+    // Exact DataColumn size of the sparse form
+    static size_t EncodedSparseColumnSize(size_t name_length, size_t count,
+                                          size_t valid, size_t element_size);
+
+    // True when the sparse form of a column with `nan_count` NaN samples is
+    // smaller than the dense one
+    static bool SparseIsSmaller(size_t count, size_t nan_count, size_t element_size);
+
+    static void AppendSparseColumn(std::string& out, const std::string& name,
+                                   const double* values, size_t count);
+    static void AppendSparseColumn(std::string& out, const std::string& name,
+                                   const float* values, size_t count);
+
+    static SerializedDataColumn EncodeSparseSerializedColumn(const std::string& name,
+                                                             const double* values, size_t count);
+    static SerializedDataColumn EncodeSparseSerializedColumn(const std::string& name,
+                                                             const float* values, size_t count);
+
+    // True if `column` holds a sparse column in the schema above
+    static bool IsSparseColumn(const DataColumn& column);
+
+    // Rebuild the dense column (one doubleValue or floatValue per sample).
+    // Returns false and leaves `dense` untouched if the structure is malformed.
+    static bool DecodeSparseColumn(const DataColumn& sparse, DataColumn& dense);
+
+    // ========== Wire Format Primitives ==========
+    static size_t VarintSize(uint64_t value);
+    static char* WriteVarint(char* out, uint64_t value);
+    static char* WriteTag(char* out, uint32_t field_number, uint32_t wire_type);
+};
+
+#endif
@@ -12,6 +12,7 @@
 #include <grpcpp/grpcpp.h>
 
 #include "common_client.hpp"  // Use our common client for shared types
+#include "channel_pool.hpp"
 #include "ingestion.pb.h"
 #include "ingestion.grpc.pb.h"
 
@@ -51,6 +52,14 @@ public:
     // Constructor with address
     explicit IngestionClient(const std::string& server_address);
     
+    // Constructor with a pool of channel_count connections to the address;
+    // unary and async calls are spread over them according to policy. The
+    // channels are opened with max_message_bytes as their message limit,
+    // which also becomes the split threshold (see SetMaxMessageBytes).
+    IngestionClient(const std::string& server_address, size_t channel_count,
+                    ChannelPool::Policy policy = ChannelPool::Policy::RoundRobin,
+                    size_t max_message_bytes = ChannelPool::DEFAULT_MAX_MESSAGE_BYTES);
+    
     ~IngestionClient();
 
     // ========== Provider Registration ==========
@@ -90,6 +99,9 @@ public:
         const std::vector<Attribute>& attributes = {},
         const std::optional<EventMetadata>& event = std::nullopt);
     
+    // Send a fully built request as-is (attached serialized columns included)
+    IngestDataResponse SendIngestRequest(const IngestDataRequest& request);
+    
     // Helper to create data frame
     IngestionDataFrame CreateDataFrame(
         const DataTimestamps& timestamps,
@@ -100,13 +112,110 @@ public:
         const SamplingClock& clock,
         const std::vector<DataColumn>& columns);
     
+    // Arena-allocated data frame; the frame and its copies of timestamps and
+    // columns are freed together with the arena
+    IngestionDataFrame* CreateDataFrame(
+        google::protobuf::Arena* arena,
+        const DataTimestamps& timestamps,
+        const std::vector<DataColumn>& columns);
+    
+    // Arena-allocated request envelope with everything but the data frame.
+    // Build one arena per batch and drop or Reset() it once the batch is sent.
+    IngestDataRequest* CreateIngestRequest(
+        google::protobuf::Arena* arena,
+        const std::string& provider_id,
+        const std::string& client_request_id,
+        const std::vector<std::string>& tags = {},
+        const std::vector<Attribute>& attributes = {},
+        const std::optional<EventMetadata>& event = std::nullopt);
+    
+    // Pack columns that share one set of timestamps into as few frames as
+    // possible: at most max_columns per frame, and no more than max_bytes of
+    // encoded frame unless a single column is larger on its own. Columns are
+    // moved into the frames.
+    std::vector<IngestionDataFrame> PackDataFrames(
+        const DataTimestamps& timestamps,
+        std::vector<DataColumn> columns,
+        size_t max_columns,
+        size_t max_bytes);
+    
+    // Same grouping for pre-encoded columns (see ColumnEncoder). Each group is
+    // meant for one request sharing `timestamps`.
+    std::vector<std::vector<SerializedDataColumn>> PackSerializedColumns(
+        const DataTimestamps& timestamps,
+        std::vector<SerializedDataColumn> columns,
+        size_t max_columns,
+        size_t max_bytes);
+    
+    // ========== Message Size ==========
+    
+    // Unary and async sends of a request larger than this are split with
+    // SplitIngestRequest and the pieces sent in parallel; the caller sees one
+    // response (the first failure, otherwise an ack summing the pieces'
+    // rows). Defaults to the channels' message limit; 0 disables splitting.
+    // Streaming sessions send requests as given.
+    void SetMaxMessageBytes(size_t bytes);
+    size_t GetMaxMessageBytes() const;
+    
+    // Cut a frame along time into consecutive frames of at most max_bytes
+    // encoded. A SamplingClock frame gives every piece its own clock starting
+    // at the piece's first sample, a TimestampList frame its slice of the
+    // list; all columns are cut at the same samples. A frame that fits, or
+    // whose columns do not all match its timestamp count, comes back as is.
+    // A piece holds at least one sample, so it only exceeds max_bytes when a
+    // single sample does.
+    static std::vector<IngestionDataFrame> SplitDataFrame(
+        const IngestionDataFrame& frame,
+        size_t max_bytes);
+    
+    // The same for a whole request, so each piece including its envelope is
+    // at most max_bytes. Pieces copy the provider, tags, attributes and event,
+    // add a "split_part" = "k/N" attribute and get client request id
+    // "<id>_part<k>". Requests with attached serialized columns cannot be cut
+    // and come back as is.
+    static std::vector<IngestDataRequest> SplitIngestRequest(
+        const IngestDataRequest& request,
+        size_t max_bytes);
+    
+    // Splice pre-encoded DataColumn bytes into the request's ingestion frame.
+    // The bytes ride along as an extra ingestionDataFrame field that the
+    // server merges with the one already set (normally just the timestamps),
+    // so they are written to the wire verbatim instead of being re-parsed.
+    // Note ingestiondataframe().datacolumns() does not see attached columns.
+    static void AttachSerializedColumns(
+        IngestDataRequest& request,
+        const std::vector<SerializedDataColumn>& columns);
+    
+    // ========== Asynchronous Data Ingestion ==========
+    
+    // Unary ingestion on a CompletionQueue: the call returns as soon as the
+    // request is serialized and on the wire, and the response is delivered
+    // from one of a small set of poller threads. At most max_in_flight calls
+    // are outstanding; further calls block until one completes. Each call gets
+    // a deadline of GetDefaultTimeout() seconds, and a missed deadline arrives
+    // as a response with an exceptional result.
+    using IngestCallback = std::function<void(const IngestDataResponse&)>;
+    
+    // Optional; the first async call starts pollers with the defaults.
+    // Settings are fixed once the pollers are running.
+    void ConfigureAsync(size_t poller_threads = 2, size_t max_in_flight = 256);
+    
+    // Callback runs on a poller thread and should not block for long
+    void IngestDataAsync(const IngestDataRequest& request, IngestCallback callback);
+    std::future<IngestDataResponse> IngestDataAsync(const IngestDataRequest& request);
+    
+    // Block until every async call issued so far has completed
+    void WaitForAsyncIdle();
+    size_t GetAsyncInFlight() const;
+    
     // ========== Streaming Data Ingestion ==========
     
     // Client-side streaming ingestion
     class StreamIngestionSession {
     public:
         StreamIngestionSession(std::shared_ptr<grpc::ClientWriter<IngestDataRequest>> writer,
-                              std::shared_ptr<grpc::ClientContext> context);
+                              std::shared_ptr<grpc::ClientContext> context,
+                              std::shared_ptr<IngestDataStreamResponse> response = nullptr);
         
         bool SendData(const IngestDataRequest& request);
         bool SendData(const std::string& provider_id,
@@ -144,6 +253,58 @@ public:
     
     std::unique_ptr<BidiStreamIngestionSession> CreateBidiStreamIngestionSession();
     
+    // ========== Bulk Streaming Ingestion ==========
+    
+    // Long-lived bidirectional stream that keeps up to max_in_flight requests
+    // unacknowledged. Responses are matched back to requests by clientRequestId
+    // on a background reader thread, so senders pay one round-trip per window
+    // instead of one per request. Send() is safe to call from several threads.
+    class BulkIngestionSession {
+    public:
+        // Invoked exactly once per request passed to Send(): with the server's
+        // response, or with an exceptional result if the stream failed first.
+        // Runs on the reader thread unless Send() fails synchronously.
+        using AckCallback = std::function<void(const IngestDataResponse&)>;
+        
+        struct BulkStats {
+            uint64_t requests_sent = 0;
+            uint64_t requests_acked = 0;
+            uint64_t requests_rejected = 0;    // Server replied with an exceptional result
+            uint64_t requests_failed = 0;      // Stream broke before a response arrived
+            uint64_t unmatched_responses = 0;  // Response carried an unknown clientRequestId
+            uint64_t bytes_sent = 0;
+            size_t peak_in_flight = 0;
+        };
+        
+        BulkIngestionSession(
+            std::shared_ptr<grpc::ClientReaderWriter<IngestDataRequest, IngestDataResponse>> stream,
+            std::shared_ptr<grpc::ClientContext> context,
+            size_t max_in_flight);
+        ~BulkIngestionSession();
+        
+        // Blocks while the window is full. Returns false once the stream is unusable.
+        bool Send(const IngestDataRequest& request, AckCallback on_ack = nullptr);
+        
+        // Block until every request sent so far has been answered
+        void Flush();
+        
+        // Half-close the stream, drain outstanding acks and collect the final status.
+        // Returns true if the stream ended cleanly and every request was acknowledged.
+        bool Finish();
+        void Cancel();
+        
+        size_t InFlight() const;
+        bool IsOpen() const;
+        BulkStats GetStats() const;
+        std::string GetLastError() const;
+        
+    private:
+        class Impl;
+        std::unique_ptr<Impl> pImpl;
+    };
+    
+    std::unique_ptr<BulkIngestionSession> CreateBulkIngestionSession(size_t max_in_flight = 64);
+    
     // ========== Request Status Query ==========
     
     // Query by provider ID
@@ -225,6 +386,10 @@ public:
     // Wait for connection
     bool WaitForConnection(int timeout_seconds = 10);
     
+    // Channel pool size and per-channel call statistics
+    size_t GetChannelCount() const;
+    std::vector<ChannelPool::ChannelStats> GetChannelStats() const;
+    
     // Get/set timeout for operations
     void SetDefaultTimeout(int seconds);
     int GetDefaultTimeout() const;
@@ -240,6 +405,8 @@ public:
         uint64_t stream_sessions = 0;
         uint64_t subscriptions = 0;
         uint64_t errors = 0;
+        uint64_t async_calls = 0;
+        size_t async_peak_in_flight = 0;
     };
     
     ClientStats GetStats() const;
@@ -11,6 +11,7 @@
 #include <grpcpp/grpcpp.h>
 
 #include "common_client.hpp"  // Use our common client for shared types
+#include "channel_pool.hpp"
 #include "query.pb.h"
 #include "query.grpc.pb.h"
 
@@ -61,6 +62,13 @@ public:
     // Constructor with address
     explicit QueryClient(const std::string& server_address);
     
+    // Constructor with a pool of channel_count connections to the address.
+    // Responses over max_message_bytes are refused by the channel, so raise
+    // it for queries that return large buckets in one response.
+    QueryClient(const std::string& server_address, size_t channel_count,
+                ChannelPool::Policy policy = ChannelPool::Policy::RoundRobin,
+                size_t max_message_bytes = ChannelPool::DEFAULT_MAX_MESSAGE_BYTES);
+    
     ~QueryClient();
 
     // ========== Time Series Data Query (Unary) ==========
@@ -244,11 +252,20 @@ public:
     // Deserialize data bucket if using serialized columns
     DataColumn DeserializeDataBucket(const DataBucket& bucket);
     
+    // Dense form of a column sent in the sparse NaN encoding (see
+    // ColumnEncoder::SPARSE_ENCODING); any other column is returned as is.
+    // The extraction methods above already apply it.
+    DataColumn ExpandSparseColumn(const DataColumn& column);
+    
     // Check connection
     bool IsConnected() const;
     grpc_connectivity_state GetChannelState() const;
     bool WaitForConnection(int timeout_seconds = 10);
     
+    // Channel pool size and per-channel call statistics
+    size_t GetChannelCount() const;
+    std::vector<ChannelPool::ChannelStats> GetChannelStats() const;
+    
     // Timeout management
     void SetDefaultTimeout(int seconds);
     int GetDefaultTimeout() const;
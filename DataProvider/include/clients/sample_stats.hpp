@@ -0,0 +1,63 @@
+#ifndef SAMPLE_STATS_HPP
+#define SAMPLE_STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Data quality and moments of one signal. NaN and Inf samples are counted;
+// everything else is taken over the finite ("valid") samples only.
+struct SampleStats {
+    static constexpr uint64_t NONE = UINT64_MAX;
+
+    uint64_t count = 0;           // Samples scanned
+    uint64_t valid = 0;           // Finite samples
+    uint64_t nan = 0;
+    uint64_t inf = 0;
+    double min = 0.0;             // 0 when there are no valid samples
+    double max = 0.0;
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    uint64_t first_valid = NONE;  // Index of the first finite sample
+    uint64_t last_valid = NONE;
+
+    bool hasValid() const { return valid > 0; }
+    double validRatio() const { return count ? static_cast<double>(valid) / count : 0.0; }
+    double mean() const { return valid ? sum / valid : 0.0; }
+    // Population variance from the two sums. Cancels badly when the spread is
+    // tiny next to the mean (e.g. 1.7e9 +/- 1e-3); take a second pass over
+    // the values where that matters.
+    double variance() const;
+    double stdDev() const;
+};
+
+/**
+ * Single streaming pass over a signal that fills every SampleStats field at
+ * once, so quality metadata costs one sweep of memory however many of the
+ * samples are NaN. Classification and accumulation are branch-free, eight
+ * (AVX-512), four (AVX2) or two (SSE2) doubles per step, scalar otherwise;
+ * floats are widened and take the double path. Lanes keep their own sums, so
+ * `sum` can differ from a sequential sum in the last bits.
+ *
+ * The AVX2 and AVX-512 kernels are built through target attributes and the
+ * widest one the CPU supports is chosen at run time (__builtin_cpu_supports),
+ * so a generic x86-64 build still uses them; no -march flag is needed.
+ *
+ * Integer samples are always valid; only the sums and extremes are computed.
+ */
+class SampleStatsKernel {
+public:
+    static SampleStats Compute(const double* values, size_t count);
+    static SampleStats Compute(const float* values, size_t count);
+    static SampleStats Compute(const int32_t* values, size_t count);
+    static SampleStats Compute(const int64_t* values, size_t count);
+    static SampleStats Compute(const uint32_t* values, size_t count);
+    static SampleStats Compute(const uint64_t* values, size_t count);
+
+private:
+    template<typename T>
+    static SampleStats computeFloating(const T* values, size_t count);
+    template<typename T>
+    static SampleStats computeIntegers(const T* values, size_t count);
+};
+
+#endif
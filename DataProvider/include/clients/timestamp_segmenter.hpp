@@ -0,0 +1,71 @@
+#ifndef TIMESTAMP_SEGMENTER_HPP
+#define TIMESTAMP_SEGMENTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A stretch of a timestamp array that can be sent as one bucket
+struct TimestampRun {
+    uint64_t first = 0;         // Index of the first sample
+    uint64_t count = 0;         // Samples in the run
+    uint64_t period_nanos = 0;  // Exact interval between samples; 0 if irregular
+    uint8_t regular = 0;        // 1: a SamplingClock describes it exactly
+
+    bool isRegular() const { return regular != 0; }
+};
+
+/**
+ * Splits a whole timestamp array into maximal runs of exactly equal
+ * intervals. Each regular run becomes one SamplingClock (start, period,
+ * count); whatever lies between runs too short to pay for a bucket of their
+ * own is grouped into irregular runs sent as TimestampLists. Every timestamp
+ * is reproduced exactly, at close to SamplingClock size for files that are
+ * regular apart from a few gaps or glitches.
+ *
+ * The interval scan compares a block of intervals per step (AVX2 or SSE2
+ * where the build allows, scalar otherwise), so a regular array costs about
+ * one pass at memory speed.
+ */
+class TimestampSegmenter {
+public:
+    // A regular run shorter than this is folded into the surrounding
+    // irregular samples: below it a TimestampList entry per sample costs less
+    // than starting another bucket. An array that is regular end to end is
+    // always one run, however short.
+    static constexpr size_t DEFAULT_MIN_RUN = 64;
+
+    // Nanoseconds since the epoch from secondsPastEpoch/nanoseconds pairs;
+    // `nanoseconds` may be null (whole seconds)
+    static void ToEpochNanos(const uint64_t* seconds, const uint64_t* nanoseconds,
+                             size_t count, uint64_t* out);
+    static std::vector<uint64_t> ToEpochNanos(const std::vector<uint64_t>& seconds,
+                                              const std::vector<uint64_t>& nanoseconds);
+
+    // Runs covering [0, count) in order. Intervals that are zero or negative
+    // (unsorted input) never form part of a regular run.
+    static std::vector<TimestampRun> Segment(const uint64_t* epoch_nanos, size_t count,
+                                             size_t min_run = DEFAULT_MIN_RUN);
+
+    // Period of the regular run covering the most samples, or 0 if none
+    static uint64_t DominantPeriod(const std::vector<TimestampRun>& runs);
+
+    // Upper bound on one encoded TimestampList entry (tag, length, and
+    // epochSeconds/nanoseconds varints)
+    static constexpr size_t MAX_LIST_ENTRY_BYTES = 19;
+
+    // Cut runs into consecutive pieces whose samples take at most max_bytes,
+    // each sample costing sample_bytes plus, in irregular runs, its list
+    // entry. A piece of a regular run is still regular, so it gets its own
+    // SamplingClock starting at its first sample. Pieces hold at least one
+    // sample, whatever the budget.
+    static std::vector<TimestampRun> Split(const std::vector<TimestampRun>& runs,
+                                           size_t sample_bytes, size_t max_bytes);
+
+private:
+    // Last index reached from `index` while every interval equals `period`
+    static size_t ExtendRun(const uint64_t* epoch_nanos, size_t count,
+                            size_t index, uint64_t period);
+};
+
+#endif
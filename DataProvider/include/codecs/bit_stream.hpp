@@ -0,0 +1,157 @@
+#ifndef BIT_STREAM_HPP
+#define BIT_STREAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * MSB-first bit streams for the codecs. The writer gathers bits in a 64-bit
+ * word and appends whole words to a std::string; the reader loads eight
+ * bytes at a time, so fields of up to 56 bits cost one load and a shift.
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::string& out) : out_(out) {}
+
+    // Low `bits` bits of `value`, most significant first; bits <= 64
+    void write(uint64_t value, unsigned bits) {
+        if (bits == 0) {
+            return;
+        }
+        if (bits < 64) {
+            value &= (uint64_t{1} << bits) - 1;
+        }
+        const unsigned free = 64 - used_;
+        if (bits <= free) {
+            word_ |= bits == 64 ? value : value << (free - bits);
+            used_ += bits;
+            if (used_ == 64) {
+                flushWord();
+            }
+            return;
+        }
+        const unsigned rest = bits - free;
+        word_ |= value >> rest;
+        used_ = 64;
+        flushWord();
+        word_ = value << (64 - rest);
+        used_ = rest;
+    }
+
+    void writeBit(bool bit) { write(bit ? 1 : 0, 1); }
+
+    // `count` zero bits, e.g. a run of repeated samples
+    void writeZeros(size_t count) {
+        while (count >= 64) {
+            write(0, 64);
+            count -= 64;
+        }
+        write(0, static_cast<unsigned>(count));
+    }
+
+    // Append the partial last word, padded with zero bits to a whole byte
+    void finish() {
+        for (unsigned shift = 56; used_ > 0; shift -= 8) {
+            out_.push_back(static_cast<char>(word_ >> shift));
+            used_ = used_ > 8 ? used_ - 8 : 0;
+        }
+        word_ = 0;
+    }
+
+private:
+    void flushWord() {
+        char bytes[8];
+        for (int i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<char>(word_ >> (56 - 8 * i));
+        }
+        out_.append(bytes, sizeof(bytes));
+        word_ = 0;
+        used_ = 0;
+    }
+
+    std::string& out_;
+    uint64_t word_ = 0;
+    unsigned used_ = 0;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : data_(data), bits_(size * 8) {}
+
+    // False, leaving the position alone, if fewer than `bits` bits remain
+    bool read(unsigned bits, uint64_t& value) {
+        if (bits == 0) {
+            value = 0;
+            return true;
+        }
+        if (bits_ - position_ < bits) {
+            return false;
+        }
+        if (bits > 56) {
+            uint64_t high = peek() >> 32;
+            position_ += 32;
+            uint64_t low = peek() >> (64 - (bits - 32));
+            position_ += bits - 32;
+            value = (high << (bits - 32)) | low;
+            return true;
+        }
+        value = peek() >> (64 - bits);
+        position_ += bits;
+        return true;
+    }
+
+    bool readBit(bool& bit) {
+        uint64_t value;
+        if (!read(1, value)) {
+            return false;
+        }
+        bit = value != 0;
+        return true;
+    }
+
+    // Consume consecutive zero bits, at most `limit`, and return how many
+    size_t skipZeros(size_t limit) {
+        size_t skipped = 0;
+        while (skipped < limit && position_ < bits_) {
+            uint64_t window = peek();
+            size_t available = std::min<size_t>(56, bits_ - position_);
+            size_t zeros = window == 0 ? 64 : static_cast<size_t>(__builtin_clzll(window));
+            size_t take = std::min(std::min(zeros, available), limit - skipped);
+            position_ += take;
+            skipped += take;
+            if (take < available) {
+                break;  // Reached a one bit or the limit
+            }
+        }
+        return skipped;
+    }
+
+private:
+    // The next 64 bits from the current position, zero past the end; at
+    // least 57 of them are real stream bits when that many remain
+    uint64_t peek() const {
+        const size_t byte = position_ / 8;
+        const size_t size = (bits_ + 7) / 8;
+        uint64_t word = 0;
+        if (byte + 8 <= size) {
+            std::memcpy(&word, data_ + byte, sizeof(word));
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            word = __builtin_bswap64(word);
+#endif
+        } else {
+            for (size_t i = 0; byte + i < size; ++i) {
+                word |= uint64_t{data_[byte + i]} << (56 - 8 * i);
+            }
+        }
+        return word << (position_ % 8);
+    }
+
+    const uint8_t* data_;
+    size_t bits_;
+    size_t position_ = 0;
+};
+
+#endif
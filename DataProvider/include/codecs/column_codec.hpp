@@ -0,0 +1,43 @@
+#ifndef COLUMN_CODEC_HPP
+#define COLUMN_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Self-describing compressed column payload, suitable for a protobuf
+ * byteArrayValue or any other byte-oriented store:
+ *
+ *   "DPC" | codec id (1 byte) | sample count (varint) | codec bit stream
+ *
+ * Doubles use XorCodec, 64-bit integers (epoch nanoseconds, counters) use
+ * DeltaOfDeltaCodec.
+ */
+class ColumnCodec {
+public:
+    enum class Codec : uint8_t {
+        NONE = 0,            // Not a codec payload
+        XOR_DOUBLE = 1,
+        DELTA_OF_DELTA = 2
+    };
+
+    static void AppendDoubles(const double* values, size_t count, std::string& out);
+    static void AppendIntegers(const uint64_t* values, size_t count, std::string& out);
+
+    // Codec named by the payload header, NONE if the header is not ours
+    static Codec Identify(const std::string& payload);
+
+    // Replace `values` with the decoded samples; false on a wrong codec or a
+    // corrupt payload
+    static bool DecodeDoubles(const std::string& payload, std::vector<double>& values);
+    static bool DecodeIntegers(const std::string& payload, std::vector<uint64_t>& values);
+
+private:
+    static void appendHeader(Codec codec, size_t count, std::string& out);
+    // Header checks; on success `count` and `offset` locate the bit stream
+    static bool readHeader(const std::string& payload, Codec expected, size_t& count, size_t& offset);
+};
+
+#endif
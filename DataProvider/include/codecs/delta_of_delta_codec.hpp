@@ -0,0 +1,33 @@
+#ifndef DELTA_OF_DELTA_CODEC_HPP
+#define DELTA_OF_DELTA_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Delta-of-delta compression for timestamps and other mostly regular 64-bit
+ * integers, after Gorilla. The first value is stored raw; each later one
+ * as the change in its delta, zigzag encoded, with the first delta taken
+ * relative to zero:
+ *
+ *   '0'           same delta as before
+ *   '10'   + 8    |dod| < 128
+ *   '110'  + 16   |dod| < 32768
+ *   '1110' + 32   |dod| < 2^31
+ *   '1111' + 64   anything else
+ *
+ * The buckets are wider than Gorilla's second-resolution ones so
+ * nanosecond jitter on a regular beam rate stays in the 8/16-bit cases.
+ * Arithmetic is modulo 2^64, so any sequence round-trips exactly.
+ */
+class DeltaOfDeltaCodec {
+public:
+    // Append the bit stream for `count` values to `out`, padded to a byte
+    static void Encode(const uint64_t* values, size_t count, std::string& out);
+
+    // Decode exactly `count` values; false if the stream is truncated
+    static bool Decode(const uint8_t* data, size_t size, size_t count, uint64_t* out);
+};
+
+#endif
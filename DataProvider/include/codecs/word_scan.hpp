@@ -0,0 +1,29 @@
+#ifndef WORD_SCAN_HPP
+#define WORD_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Vectorised pre-passes shared by the codecs. Each one turns a column into
+ * the 64-bit words a codec actually writes (XORs of neighbouring doubles,
+ * timestamp delta-of-deltas) so the bit-packing loop is left with no
+ * arithmetic, and ZeroRun lets that loop emit a run of repeated samples as
+ * one block of zero bits. AVX2 when the CPU has it, chosen at run time
+ * through a target attribute and __builtin_cpu_supports so no -march flag
+ * is needed; SSE2 or scalar otherwise.
+ */
+class WordScan {
+public:
+    // out[0] = bits of values[0]; out[i] = bits(values[i]) ^ bits(values[i-1])
+    static void XorAdjacent(const double* values, size_t count, uint64_t* out);
+
+    // out[0] = 0; out[1] = t[1] - t[0]; out[i] = (t[i] - t[i-1]) - (t[i-1] - t[i-2]),
+    // all modulo 2^64
+    static void DeltaOfDeltas(const uint64_t* timestamps, size_t count, uint64_t* out);
+
+    // Number of consecutive zero words starting at words[begin]
+    static size_t ZeroRun(const uint64_t* words, size_t begin, size_t count);
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef XOR_CODEC_HPP
+#define XOR_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Gorilla XOR compression for doubles (Pelkonen et al., VLDB 2015). The first
+ * value is stored raw; after that each value is XORed with its predecessor:
+ *
+ *   '0'                               identical to the previous value
+ *   '10' + meaningful bits            XOR fits the previous leading/trailing
+ *                                     zero window
+ *   '11' + 5-bit leading zeros +      new window
+ *          6-bit length (0 = 64) + meaningful bits
+ *
+ * Slowly varying PV readbacks need a handful of bits per sample and
+ * repeated readbacks one bit. Round trips are bit-exact, NaN payloads included.
+ */
+class XorCodec {
+public:
+    // Append the bit stream for `count` values to `out`, padded to a byte
+    static void Encode(const double* values, size_t count, std::string& out);
+
+    // Decode exactly `count` values; false if the stream is truncated or malformed
+    static bool Decode(const uint8_t* data, size_t size, size_t count, double* out);
+};
+
+#endif
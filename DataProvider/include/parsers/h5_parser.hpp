@@ -4,9 +4,15 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <cstdint>
 #include <memory>
+#include <variant>
+#include <string_view>
+#include <type_traits>
 #include <H5Cpp.h>
+#include "clients/timestamp_segmenter.hpp"
+#include "clients/sample_stats.hpp"
 
 // File metadata extracted from naming convention
 struct H5FileMetadata {
@@ -37,22 +43,338 @@ struct SignalInfo {
 struct TimestampData {
     std::vector<uint64_t> seconds;    // secondsPastEpoch array
     std::vector<uint64_t> nanoseconds; // nanoseconds array
-    uint64_t period_nanos = 1000000000; // Calculated sampling period
-    bool is_regular_sampling = false; // True if regular sampling detected
+    uint64_t period_nanos = 1000000000; // Period of the longest regular run
+    bool is_regular_sampling = false; // Every interval within 1 us of period_nanos
+    std::vector<TimestampRun> runs;   // Exact SamplingClock/TimestampList buckets, in order
     size_t count = 0;                 // Number of timestamps
+    size_t first_index = 0;           // File position of seconds[0] (non-zero under a time window)
+    size_t file_count = 0;            // Timestamps in the whole file, 0 if unknown
     uint64_t start_time_sec = 0;      // First timestamp seconds
     uint64_t start_time_nano = 0;     // First timestamp nanoseconds
     uint64_t end_time_sec = 0;        // Last timestamp seconds
     uint64_t end_time_nano = 0;       // Last timestamp nanoseconds
 };
 
+// Signal samples in the element type they were stored with. The
+// alternatives are the numeric DataValue cases, in H5NumericReader::Storage
+// order.
+using SignalColumn = std::variant<std::vector<double>, std::vector<float>,
+                                  std::vector<int32_t>, std::vector<int64_t>,
+                                  std::vector<uint32_t>, std::vector<uint64_t>>;
+
 // Complete signal data
 struct SignalData {
     SignalInfo info;                  // Parsed signal metadata
-    std::vector<double> values;       // Signal values
+    std::vector<double> values;       // Signal values (empty when `column` holds them)
+    SignalColumn column;              // Native-typed values, see H5Parser::setPreserveNativeTypes
     std::shared_ptr<TimestampData> timestamps; // Shared timestamp reference
     H5FileMetadata file_metadata;     // Source file metadata
     bool spatial_enrichment_ready = false; // Flag for spatial enrichment
+    SampleStats quality;              // NaN/Inf counts and moments, filled by the parser
+
+    // Sample count and a widened copy, whichever representation is filled
+    size_t sampleCount() const;
+    std::vector<double> toDoubleValues() const;
+};
+
+// Receives signals from H5Parser::parseDirectory(SignalVisitor&) as they are
+// read. Signals are handed over by move and the parser keeps nothing, so
+// memory use is bounded by what the visitor itself holds on to.
+class SignalVisitor {
+public:
+    virtual ~SignalVisitor() = default;
+
+    // A file was opened; timestamps is null when the file has none usable.
+    // Every signal of the file shares this timestamps object.
+    virtual void onFileStart(const H5FileMetadata& /*file*/,
+                             const std::shared_ptr<TimestampData>& /*timestamps*/) {}
+
+    virtual void onSignal(SignalData&& signal) = 0;
+
+    // All signals of an opened file have been delivered
+    virtual void onFileEnd(const H5FileMetadata& /*file*/, size_t /*signal_count*/) {}
+};
+
+// Reads numeric datasets into doubles. The on-disk type is looked up once
+// and the read goes straight to a matching memory type, so HDF5 is never
+// asked for a conversion it refuses; float32 and int32 data are read as-is
+// and widened with SIMD afterwards.
+class H5NumericReader {
+public:
+    // Element type a dataset is kept in; the order matches SignalColumn
+    enum class Storage {
+        Float64,     // Doubles, and floats that are neither 4 nor 8 bytes
+        Float32,     // Read as NATIVE_FLOAT, widened in SIMD for doubles
+        Int32,       // Signed integers up to 32 bits, widened in SIMD for doubles
+        Int64,       // Wider signed integers; HDF5 converts them for doubles
+        UInt32,      // Unsigned integers up to 32 bits; HDF5 converts for doubles
+        UInt64,      // Wider unsigned integers; HDF5 converts for doubles
+        Unsupported  // Not numeric (strings, compounds, ...)
+    };
+
+    static Storage classify(const H5::DataSet& dataset);
+    static const H5::PredType& memoryType(Storage storage);
+
+    // Read the selection into `out`, which must hold `count` doubles.
+    // Returns false without reading when the dataset is not numeric; HDF5
+    // errors still surface as H5::Exception.
+    static bool read(const H5::DataSet& dataset, Storage storage,
+                     double* out, size_t count,
+                     const H5::DataSpace& memspace = H5::DataSpace::ALL,
+                     const H5::DataSpace& filespace = H5::DataSpace::ALL);
+
+    static bool read(const H5::DataSet& dataset, double* out, size_t count,
+                     const H5::DataSpace& memspace = H5::DataSpace::ALL,
+                     const H5::DataSpace& filespace = H5::DataSpace::ALL) {
+        return read(dataset, classify(dataset), out, count, memspace, filespace);
+    }
+
+    // Read the selection without conversion into a column of the stored
+    // element type, resized to `count`. Returns false for non-numeric data.
+    static bool readNative(const H5::DataSet& dataset, Storage storage,
+                           SignalColumn& column, size_t count,
+                           const H5::DataSpace& memspace = H5::DataSpace::ALL,
+                           const H5::DataSpace& filespace = H5::DataSpace::ALL);
+
+    static void widen(const float* src, double* dst, size_t count);
+    static void widen(const int32_t* src, double* dst, size_t count);
+};
+
+// Stored bytes of every chunk of a 1D chunked dataset, as fetched by
+// H5ChunkReader::fetch. Holds no HDF5 handles, so it can be decoded on any
+// thread once the HDF5 lock has been released.
+struct RawChunkedDataset {
+    struct Chunk {
+        uint32_t filter_mask = 0;     // Bit i set: filter i was skipped for this chunk
+        std::vector<uint8_t> bytes;   // Chunk as stored in the file
+    };
+
+    H5NumericReader::Storage storage = H5NumericReader::Storage::Unsupported;
+    size_t element_size = 0;          // Bytes per sample, equal to the memory type's
+    size_t sample_count = 0;          // Samples in the dataset
+    size_t chunk_samples = 0;         // Samples per (full) chunk
+    std::vector<int> filters;         // H5Z filter ids in write order
+    std::vector<Chunk> chunks;        // Chunk i starts at sample i * chunk_samples
+
+    size_t chunkOffset(size_t index) const { return index * chunk_samples; }
+    size_t chunkLength(size_t index) const;
+    size_t storedBytes() const;
+};
+
+// Direct chunk access for compressed 1D datasets. A filtered dataset.read()
+// inflates inside HDF5, i.e. under whatever lock serializes HDF5 calls;
+// fetch() only copies the stored chunk bytes with H5Dread_chunk, and
+// decodeChunk() inflates and unshuffles them with zlib without touching
+// HDF5, so chunks can be decoded in parallel after the lock is released.
+class H5ChunkReader {
+public:
+    // Fetch every chunk of `dataset`. Returns false, leaving `raw` empty, when
+    // the dataset is not a 1D chunked numeric dataset stored in the native
+    // memory layout, is unfiltered or uses a filter other than deflate and
+    // shuffle, or has unallocated chunks; a plain dataset.read() handles
+    // those. HDF5 errors still surface as H5::Exception.
+    static bool fetch(const H5::DataSet& dataset, RawChunkedDataset& raw);
+
+    // Decode chunk `index` into `out`, which must hold raw.chunkLength(index)
+    // elements of the stored type. Safe to call concurrently for different
+    // chunks. Returns false on corrupt chunk data.
+    static bool decodeChunk(const RawChunkedDataset& raw, size_t index, void* out);
+
+    // Decode all chunks in order into `out` (raw.sample_count elements)
+    static bool decode(const RawChunkedDataset& raw, void* out);
+};
+
+// Read-only mmap of a whole H5 file. Views into it share ownership, so the
+// mapping lives as long as the last of them. The file must not be truncated
+// while mapped.
+class MappedH5File {
+public:
+    // Null if the file cannot be opened or mapped
+    static std::shared_ptr<const MappedH5File> open(const std::string& filepath);
+    ~MappedH5File();
+
+    MappedH5File(const MappedH5File&) = delete;
+    MappedH5File& operator=(const MappedH5File&) = delete;
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    MappedH5File(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    const uint8_t* data_;
+    size_t size_;
+};
+
+// Zero-copy samples inside a MappedH5File: a pointer and a count (what
+// std::span<const T> would be) that keeps the mapping alive
+template <typename T>
+class SampleView {
+public:
+    SampleView() = default;
+    SampleView(std::shared_ptr<const MappedH5File> mapping, const T* data, size_t size)
+        : mapping_(std::move(mapping)), data_(data), size_(size) {}
+
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const T& operator[](size_t i) const { return data_[i]; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+
+private:
+    std::shared_ptr<const MappedH5File> mapping_;
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Where a contiguous 1D dataset keeps its samples in the file, as found by
+// H5ContiguousReader::locate
+struct ContiguousExtent {
+    H5NumericReader::Storage storage = H5NumericReader::Storage::Unsupported;
+    uint64_t offset = 0;              // File offset of sample 0
+    size_t element_size = 0;          // Bytes per sample, equal to the memory type's
+    size_t sample_count = 0;          // Samples in the dataset
+
+    // Bytes of samples [first, first + count), or null if they fall outside
+    // the mapping (a truncated file)
+    const uint8_t* bytes(const MappedH5File& mapping, size_t first, size_t count) const;
+};
+
+// Contiguous, unfiltered datasets in the native layout are a plain array in
+// the file, so once locate() has found it (one HDF5 metadata call) the
+// samples can be read from a MappedH5File by any number of threads without
+// HDF5 or its lock.
+class H5ContiguousReader {
+public:
+    // False when the dataset is not 1D, not contiguous, not yet allocated,
+    // stored externally or not stored in the native memory type
+    static bool locate(const H5::DataSet& dataset, ContiguousExtent& extent);
+
+    // Zero-copy view of samples [first, first + count). Empty when T is not
+    // the stored type, the range is outside the mapping or the samples are
+    // not aligned for T; copy() works in those cases.
+    template <typename T>
+    static SampleView<T> view(const ContiguousExtent& extent,
+                              const std::shared_ptr<const MappedH5File>& mapping,
+                              size_t first, size_t count);
+
+    // Copy samples [first, first + count) out of the mapping, widened to
+    // double or in the stored type. Return false if the range is outside
+    // the mapping.
+    static bool copy(const ContiguousExtent& extent, const MappedH5File& mapping,
+                     size_t first, size_t count, double* out);
+    static bool copyNative(const ContiguousExtent& extent, const MappedH5File& mapping,
+                           size_t first, size_t count, SignalColumn& column);
+
+private:
+    template <typename T>
+    static constexpr H5NumericReader::Storage storageOf() {
+        using Storage = H5NumericReader::Storage;
+        if constexpr (std::is_same_v<T, double>) return Storage::Float64;
+        else if constexpr (std::is_same_v<T, float>) return Storage::Float32;
+        else if constexpr (std::is_same_v<T, int32_t>) return Storage::Int32;
+        else if constexpr (std::is_same_v<T, int64_t>) return Storage::Int64;
+        else if constexpr (std::is_same_v<T, uint32_t>) return Storage::UInt32;
+        else if constexpr (std::is_same_v<T, uint64_t>) return Storage::UInt64;
+        else return Storage::Unsupported;
+    }
+};
+
+template <typename T>
+SampleView<T> H5ContiguousReader::view(const ContiguousExtent& extent,
+                                       const std::shared_ptr<const MappedH5File>& mapping,
+                                       size_t first, size_t count) {
+    if (!mapping || extent.storage != storageOf<T>() || extent.element_size != sizeof(T)) {
+        return SampleView<T>();
+    }
+    const uint8_t* bytes = extent.bytes(*mapping, first, count);
+    if (!bytes || reinterpret_cast<uintptr_t>(bytes) % alignof(T) != 0) {
+        return SampleView<T>();
+    }
+    return SampleView<T>(mapping, reinterpret_cast<const T*>(bytes), count);
+}
+
+// One window of a signal read by SignalChunkReader
+struct SignalChunk {
+    size_t offset = 0;                // Index of the first sample in the signal
+    std::vector<double> values;       // Samples [offset, offset + values.size())
+    std::vector<uint64_t> seconds;    // Matching slice of secondsPastEpoch
+    std::vector<uint64_t> nanoseconds; // Matching slice of nanoseconds (zeros if absent)
+};
+
+// Pull-style reader over one signal dataset. Each next() reads one hyperslab
+// window of the time dimension plus the same window of the file timestamps,
+// so the working set is bounded by the chunk size however long the signal is.
+// Like the rest of the HDF5 access here, a reader must not be used from two
+// threads at once.
+class SignalChunkReader {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SAMPLES = 65536;
+
+    SignalChunkReader(const std::string& filepath,
+                      const std::string& signal_name,
+                      size_t chunk_samples = DEFAULT_CHUNK_SAMPLES);
+    ~SignalChunkReader();
+
+    SignalChunkReader(const SignalChunkReader&) = delete;
+    SignalChunkReader& operator=(const SignalChunkReader&) = delete;
+
+    // False if the file, dataset or timestamps could not be opened
+    bool isOpen() const { return open_; }
+    const std::string& getLastError() const { return last_error_; }
+
+    const std::string& getSignalName() const { return signal_name_; }
+    size_t getTotalSamples() const { return total_samples_; }
+    size_t getChunkSamples() const { return chunk_samples_; }
+    size_t getPosition() const { return position_; }
+
+    // Fill `chunk` with the next window; its buffers are reused between
+    // calls. Returns false at the end of the signal or on a read error.
+    bool next(SignalChunk& chunk);
+
+    // Continue reading from `sample`
+    void seek(size_t sample);
+
+private:
+    std::string signal_name_;
+    size_t chunk_samples_;
+    size_t total_samples_ = 0;
+    size_t position_ = 0;
+    bool open_ = false;
+    std::string last_error_;
+
+    H5::H5File file_;
+    H5::DataSet dataset_;
+    H5::DataSet seconds_ds_;
+    H5::DataSet nanos_ds_;
+    bool has_nanos_ = false;
+
+    int ndims_ = 0;
+    int time_dim_index_ = 0;
+    hsize_t dims_[3] = {0, 0, 0};
+    H5NumericReader::Storage storage_ = H5NumericReader::Storage::Unsupported;
+
+    bool readWindow(size_t offset, size_t count, SignalChunk& chunk);
+};
+
+// Which signals H5Parser reads, decided from the dataset name alone so that
+// nothing else is opened or read. A signal is selected when it matches at
+// least one include glob (or there are none), no exclude glob, and every
+// non-empty field list. Globs match the whole name ('*' any run, '?' one
+// character). The field lists compare exactly against the DEVICE, AREA and
+// ATTRIBUTE parts of a DEVICE_AREA_LOCATION_ATTRIBUTE name; names that do
+// not follow that convention fail any field predicate.
+struct SignalSelector {
+    std::vector<std::string> include;     // e.g. "BPMS_*", "KLYS_*_AMPL"
+    std::vector<std::string> exclude;
+    std::vector<std::string> devices;     // e.g. "KLYS"
+    std::vector<std::string> areas;       // e.g. "LI23"
+    std::vector<std::string> attributes;  // e.g. "AMPL"
+
+    bool empty() const;
+    bool matches(std::string_view signal_name) const;
 };
 
 // Main parser class
@@ -65,18 +387,75 @@ public:
     void enableSpatialEnrichment(bool enable = true);
     bool isSpatialEnrichmentEnabled() const { return spatial_enrichment_enabled_; }
 
+    // Multi-process reading for parseDirectory(): with N > 1, files are read
+    // by N forked reader processes, each with its own HDF5 library state, and
+    // the decoded signals come back through shared memory. Results are merged
+    // in file order, so the outcome matches a sequential parse. 0 or 1 keeps
+    // everything in this process.
+    void setParallelReaders(size_t processes) { parallel_readers_ = processes; }
+    size_t getParallelReaders() const { return parallel_readers_; }
+
+    // Time-range pushdown: read only samples with begin <= t <= end, both in
+    // nanoseconds since the epoch. secondsPastEpoch must be sorted; the range
+    // is located by binary search and every dataset is read through a
+    // hyperslab covering just that range. Files with no samples in the
+    // window yield no signals.
+    void setTimeWindow(uint64_t begin_nanos, uint64_t end_nanos);
+    void clearTimeWindow();
+    bool hasTimeWindow() const { return time_window_set_; }
+
+    // Signal-name pushdown: datasets the selector rejects are skipped while
+    // listing the file, before any of them is opened
+    void setSignalSelector(SignalSelector selector) { selector_ = std::move(selector); }
+    void clearSignalSelector() { selector_ = SignalSelector(); }
+    const SignalSelector& getSignalSelector() const { return selector_; }
+
+    // Keep each signal in its stored element type (SignalData::column)
+    // instead of widening it to double in SignalData::values. float32 and
+    // 32-bit integer signals then take half the memory.
+    void setPreserveNativeTypes(bool preserve) { preserve_native_types_ = preserve; }
+    bool getPreserveNativeTypes() const { return preserve_native_types_; }
+
+    // Copy contiguous, uncompressed 1D signals out of an mmap of the file
+    // instead of going through dataset.read(). On by default; results are
+    // the same either way. See H5ContiguousReader for zero-copy access.
+    void setMemoryMapping(bool enable) { memory_mapping_ = enable; }
+    bool getMemoryMapping() const { return memory_mapping_; }
+
     // Main parsing functions
     bool parseDirectory();
     virtual bool parseFile(const std::string& filepath);
 
-    // Data access
+    // Streaming parse: each signal goes to the visitor as soon as it is read
+    // and is not kept in parsed_signals_. With parallel readers, files are
+    // still delivered whole and in order.
+    bool parseDirectory(SignalVisitor& visitor);
+    bool parseFile(const std::string& filepath, SignalVisitor& visitor);
+
+    // Streaming access that bypasses parsed_signals_: list a file's signal
+    // datasets, then read any of them window by window
+    std::vector<std::string> listSignals(const std::string& filepath) const;
+    std::unique_ptr<SignalChunkReader> openSignalReader(
+        const std::string& filepath,
+        const std::string& signal_name,
+        size_t chunk_samples = SignalChunkReader::DEFAULT_CHUNK_SAMPLES) const;
+
+    // Data access (getAllSignals and getSignalsBy* return deep copies)
     std::vector<SignalData> getAllSignals() const;
     std::vector<SignalData> getSignalsByDevice(const std::string& device) const;
     std::vector<SignalData> getSignalsByDeviceArea(const std::string& device_area) const;
     std::vector<SignalData> getSignalsByDeviceAttribute(const std::string& device_attribute) const;
     std::vector<SignalData> getSignalsByProject(const std::string& project) const;
 
-    // Individual signal lookup
+    // Indexed, copy-free lookups. The pointers refer into the parser's own
+    // storage and stay valid until the next parse call.
+    using SignalRefs = std::vector<const SignalData*>;
+    SignalRefs findSignalsByDevice(const std::string& device) const;
+    SignalRefs findSignalsByDeviceArea(const std::string& device_area) const;
+    SignalRefs findSignalsByDeviceAttribute(const std::string& device_attribute) const;
+    SignalRefs findSignalsByProject(const std::string& project) const;
+
+    // Individual signal lookup (first signal parsed under that name)
     SignalData* findSignal(const std::string& signal_name);
     const SignalData* findSignal(const std::string& signal_name) const;
 
@@ -88,13 +467,42 @@ public:
     std::vector<H5FileMetadata> getFileMetadata() const;
 
 protected:
+    class CollectingVisitor;  // Feeds parsed_signals_ and file_timestamps_
+
     std::string h5_directory_;
     std::vector<SignalData> parsed_signals_;
     std::map<std::string, std::shared_ptr<TimestampData>> file_timestamps_;
     bool spatial_enrichment_enabled_;
+    size_t parallel_readers_ = 0;
+    bool preserve_native_types_ = false;
+    bool memory_mapping_ = true;
+    bool time_window_set_ = false;
+    uint64_t window_begin_nanos_ = 0;
+    uint64_t window_end_nanos_ = 0;
+    SignalSelector selector_;
+
+    // Hash indexes over parsed_signals_ positions, kept up to date as
+    // signals are collected. Subclasses that edit parsed_signals_ directly
+    // must call rebuildIndexes() afterwards.
+    std::unordered_map<std::string, size_t> name_index_;
+    std::unordered_map<std::string, std::vector<size_t>> device_index_;
+    std::unordered_map<std::string, std::vector<size_t>> device_area_index_;
+    std::unordered_map<std::string, std::vector<size_t>> device_attribute_index_;
+    std::unordered_map<std::string, std::vector<size_t>> project_index_;
+
+    void indexSignal(size_t position);
+    void rebuildIndexes();
+    SignalRefs lookup(const std::unordered_map<std::string, std::vector<size_t>>& index,
+                      const std::string& key) const;
+
+    // Parse files in forked reader processes; returns the number of files
+    // that parsed successfully
+    size_t parseFilesInReaderProcesses(const std::vector<std::string>& files,
+                                       SignalVisitor& visitor);
 
     // File discovery and validation
     std::vector<std::string> discoverH5Files() const;
+    std::vector<std::string> discoverParsableFiles() const;  // Sorted, naming convention only
     bool matchesNamingConvention(const std::string& filepath) const;
 
     // Filename parsing
@@ -103,6 +511,8 @@ protected:
 
     // H5 file processing
     std::shared_ptr<TimestampData> extractTimestamps(H5::H5File& file) const;
+    size_t lowerBoundSample(const H5::DataSet& seconds_ds, const H5::DataSet* nanos_ds,
+                            size_t count, uint64_t target_nanos) const;
     std::vector<std::string> getSignalDatasets(H5::H5File& file) const;
 
     // Signal processing
@@ -110,7 +520,8 @@ protected:
     SignalData processSignal(H5::H5File& file,
                            const std::string& signal_name,
                            std::shared_ptr<TimestampData> timestamps,
-                           const H5FileMetadata& file_metadata) const;
+                           const H5FileMetadata& file_metadata,
+                           const MappedH5File* mapping = nullptr) const;
 
     // H5 attribute reading
     std::string readStringAttribute(H5::DataSet& dataset, const std::string& attr_name) const;
@@ -126,10 +537,9 @@ protected:
     std::string inferUnits(const std::string& device_attribute) const;
     std::string inferSignalType(const std::string& device_attribute) const;
 
-    // Validation
-    bool validateDataConsistency(const std::vector<double>& values,
-                               const TimestampData& timestamps,
-                               const std::string& signal_name) const;
+    // Validation; also fills signal.quality
+    bool validateDataConsistency(SignalData& signal,
+                               const TimestampData& timestamps) const;
 };
 
 #endif // H5_PARSER_HPP
\ No newline at end of file
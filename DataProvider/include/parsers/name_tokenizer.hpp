@@ -0,0 +1,167 @@
+#ifndef NAME_TOKENIZER_HPP
+#define NAME_TOKENIZER_HPP
+
+#include <string_view>
+#include <cstddef>
+
+/**
+ * Allocation-free tokenizers for the names the ingest paths take apart:
+ * H5 file names, underscore-separated signal names and colon-separated
+ * EPICS PV names. Every token is a string_view into the input, so the input
+ * must outlive the tokens.
+ *
+ * These replace per-call std::regex objects; the grammars are the same as
+ * the regexes they replace (noted on each function).
+ */
+class NameTokenizer {
+public:
+    // ========== Character Classes ==========
+    static constexpr bool IsUpper(char c) { return c >= 'A' && c <= 'Z'; }
+    static constexpr bool IsLower(char c) { return c >= 'a' && c <= 'z'; }
+    static constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+    static constexpr bool IsUpperOrDigit(char c) { return IsUpper(c) || IsDigit(c); }
+    static constexpr bool IsAlnum(char c) { return IsUpper(c) || IsLower(c) || IsDigit(c); }
+
+    // True if `text` is non-empty and every character satisfies `cls`
+    template<typename CharClass>
+    static constexpr bool AllOf(std::string_view text, CharClass cls) {
+        if (text.empty()) {
+            return false;
+        }
+        for (char c : text) {
+            if (!cls(c)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // ========== Splitting ==========
+
+    // Store up to max_fields fields of `text` separated by `delimiter` in
+    // `fields` and return how many were stored. A trailing delimiter does not
+    // start an empty field, and an empty text has no fields, the same as
+    // splitting with std::getline.
+    static constexpr size_t Split(std::string_view text, char delimiter,
+                                  std::string_view* fields, size_t max_fields) {
+        size_t count = 0;
+        size_t pos = 0;
+        while (pos < text.size() && count < max_fields) {
+            size_t next = text.find(delimiter, pos);
+            if (next == std::string_view::npos) {
+                fields[count++] = text.substr(pos);
+                break;
+            }
+            fields[count++] = text.substr(pos, next - pos);
+            pos = next + 1;
+        }
+        return count;
+    }
+
+    // File name without directories and extension, as std::filesystem::path::stem()
+    static constexpr std::string_view Stem(std::string_view path) {
+        size_t slash = path.rfind('/');
+        std::string_view filename = slash == std::string_view::npos ? path : path.substr(slash + 1);
+        if (filename == "." || filename == "..") {
+            return filename;
+        }
+        size_t dot = filename.rfind('.');
+        return (dot == std::string_view::npos || dot == 0) ? filename : filename.substr(0, dot);
+    }
+
+    // Shell-style match of the whole text: '*' matches any run of characters
+    // (including none), '?' exactly one, everything else itself
+    static constexpr bool GlobMatch(std::string_view pattern, std::string_view text) {
+        size_t p = 0;
+        size_t t = 0;
+        size_t star = std::string_view::npos;  // Last '*' seen in the pattern
+        size_t resume = 0;                     // Text position that '*' is stretched to
+        while (t < text.size()) {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+                ++p;
+                ++t;
+            } else if (p < pattern.size() && pattern[p] == '*') {
+                star = p++;
+                resume = t;
+            } else if (star != std::string_view::npos) {
+                p = star + 1;
+                t = ++resume;
+            } else {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*') {
+            ++p;
+        }
+        return p == pattern.size();
+    }
+
+    // ========== H5 File Names ==========
+
+    // ORIGIN_PATHWAY_YYYYMMDD_HHMMSS[_PROJECT]
+    // ([A-Z]+)_([A-Z]+)_(\d{8})_(\d{6})(?:_([A-Za-z0-9]+))?
+    struct FilenameTokens {
+        std::string_view origin;
+        std::string_view pathway;
+        std::string_view date;
+        std::string_view time;
+        std::string_view project;  // Empty when the name has none
+    };
+
+    static constexpr bool ParseFilename(std::string_view stem, FilenameTokens& tokens) {
+        std::string_view fields[6];
+        size_t count = Split(stem, '_', fields, 6);
+        if ((count != 4 && count != 5) || stem.back() == '_') {
+            return false;
+        }
+        if (!AllOf(fields[0], IsUpper) || !AllOf(fields[1], IsUpper) ||
+            fields[2].size() != 8 || !AllOf(fields[2], IsDigit) ||
+            fields[3].size() != 6 || !AllOf(fields[3], IsDigit) ||
+            (count == 5 && !AllOf(fields[4], IsAlnum))) {
+            return false;
+        }
+        tokens.origin = fields[0];
+        tokens.pathway = fields[1];
+        tokens.date = fields[2];
+        tokens.time = fields[3];
+        tokens.project = count == 5 ? fields[4] : std::string_view();
+        return true;
+    }
+
+    // ========== Signal Names ==========
+
+    // DEVICE_AREA_LOCATION_ATTRIBUTE, where the attribute may contain underscores
+    // ([A-Z]+)_([A-Z0-9]+)_(\d+)_([A-Z0-9_]+)
+    struct SignalNameTokens {
+        std::string_view device;
+        std::string_view area;
+        std::string_view location;
+        std::string_view attribute;
+    };
+
+    static constexpr bool ParseSignalName(std::string_view name, SignalNameTokens& tokens) {
+        std::string_view fields[3];
+        size_t prefix = 0;
+        for (size_t i = 0; i < 3; ++i) {
+            size_t next = name.find('_', prefix);
+            if (next == std::string_view::npos) {
+                return false;
+            }
+            fields[i] = name.substr(prefix, next - prefix);
+            prefix = next + 1;
+        }
+        std::string_view attribute = name.substr(prefix);
+        if (!AllOf(fields[0], IsUpper) || !AllOf(fields[1], IsUpperOrDigit) ||
+            !AllOf(fields[2], IsDigit) ||
+            !AllOf(attribute, [](char c) { return IsUpperOrDigit(c) || c == '_'; })) {
+            return false;
+        }
+        tokens.device = fields[0];
+        tokens.area = fields[1];
+        tokens.location = fields[2];
+        tokens.attribute = attribute;
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "channel_pool.hpp"
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+grpc::ChannelArguments messageSizeArguments(size_t max_message_bytes) {
+    grpc::ChannelArguments args;
+    int limit = static_cast<int>(std::min<size_t>(max_message_bytes, INT_MAX));
+    args.SetMaxSendMessageSize(limit);
+    args.SetMaxReceiveMessageSize(limit);
+    return args;
+}
+
+// Channels created with identical arguments share subchannels (and so the
+// TCP connection) through gRPC's global subchannel pool. A per-channel pool
+// plus a distinguishing argument gives every channel its own connection.
+std::shared_ptr<grpc::Channel> createDedicatedChannel(const std::string& server_address, size_t index,
+                                                      size_t max_message_bytes) {
+    grpc::ChannelArguments args = messageSizeArguments(max_message_bytes);
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    args.SetInt("dp.channel_pool_index", static_cast<int>(index));
+    return grpc::CreateCustomChannel(server_address, grpc::InsecureChannelCredentials(), args);
+}
+
+int stateRank(grpc_connectivity_state state) {
+    switch (state) {
+        case GRPC_CHANNEL_READY: return 4;
+        case GRPC_CHANNEL_CONNECTING: return 3;
+        case GRPC_CHANNEL_IDLE: return 2;
+        case GRPC_CHANNEL_TRANSIENT_FAILURE: return 1;
+        default: return 0;
+    }
+}
+
+} // namespace
+
+ChannelPool::ChannelPool(const std::string& server_address, size_t channel_count, Policy policy,
+                         size_t max_message_bytes)
+    : policy_(policy), max_message_bytes_(max_message_bytes) {
+    channel_count = std::max<size_t>(1, channel_count);
+    slots_.reserve(channel_count);
+    for (size_t i = 0; i < channel_count; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->channel = channel_count == 1
+            ? grpc::CreateCustomChannel(server_address, grpc::InsecureChannelCredentials(),
+                                        messageSizeArguments(max_message_bytes))
+            : createDedicatedChannel(server_address, i, max_message_bytes);
+        slots_.push_back(std::move(slot));
+    }
+}
+
+ChannelPool::ChannelPool(std::shared_ptr<grpc::Channel> channel)
+    : policy_(Policy::RoundRobin) {
+    auto slot = std::make_unique<Slot>();
+    slot->channel = std::move(channel);
+    slots_.push_back(std::move(slot));
+}
+
+ChannelPool::~ChannelPool() = default;
+
+size_t ChannelPool::Size() const {
+    return slots_.size();
+}
+
+ChannelPool::Policy ChannelPool::GetPolicy() const {
+    return policy_;
+}
+
+size_t ChannelPool::GetMaxMessageBytes() const {
+    return max_message_bytes_;
+}
+
+std::shared_ptr<grpc::Channel> ChannelPool::GetChannel(size_t index) const {
+    return slots_[index % slots_.size()]->channel;
+}
+
+// ========== Channel Selection ==========
+
+size_t ChannelPool::Acquire() {
+    const size_t count = slots_.size();
+    size_t start = next_.fetch_add(1, std::memory_order_relaxed) % count;
+    size_t chosen = start;
+
+    if (policy_ == Policy::LeastOutstanding && count > 1) {
+        // Scan from a rotating start so ties (e.g. an idle pool) still spread
+        size_t best = slots_[start]->outstanding.load(std::memory_order_relaxed);
+        for (size_t i = 1; i < count && best > 0; ++i) {
+            size_t index = (start + i) % count;
+            size_t outstanding = slots_[index]->outstanding.load(std::memory_order_relaxed);
+            if (outstanding < best) {
+                best = outstanding;
+                chosen = index;
+            }
+        }
+    }
+
+    Slot& slot = *slots_[chosen];
+    slot.calls.fetch_add(1, std::memory_order_relaxed);
+    size_t outstanding = slot.outstanding.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t peak = slot.peak_outstanding.load(std::memory_order_relaxed);
+    while (outstanding > peak &&
+           !slot.peak_outstanding.compare_exchange_weak(peak, outstanding, std::memory_order_relaxed)) {
+    }
+    return chosen;
+}
+
+void ChannelPool::Release(size_t index, bool ok) {
+    Slot& slot = *slots_[index % slots_.size()];
+    if (!ok) {
+        slot.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot.outstanding.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// ========== Connectivity ==========
+
+bool ChannelPool::IsConnected() const {
+    return GetState(false) == GRPC_CHANNEL_READY;
+}
+
+grpc_connectivity_state ChannelPool::GetState(bool try_to_connect) const {
+    grpc_connectivity_state best = GRPC_CHANNEL_SHUTDOWN;
+    for (const auto& slot : slots_) {
+        grpc_connectivity_state state = slot->channel->GetState(try_to_connect);
+        if (stateRank(state) > stateRank(best)) {
+            best = state;
+        }
+    }
+    return best;
+}
+
+bool ChannelPool::WaitForConnected(std::chrono::system_clock::time_point deadline) {
+    bool connected = true;
+    for (auto& slot : slots_) {
+        connected = slot->channel->WaitForConnected(deadline) && connected;
+    }
+    return connected;
+}
+
+// ========== Statistics ==========
+
+std::vector<ChannelPool::ChannelStats> ChannelPool::GetStats() const {
+    std::vector<ChannelStats> stats;
+    stats.reserve(slots_.size());
+    for (const auto& slot : slots_) {
+        ChannelStats entry;
+        entry.calls = slot->calls.load(std::memory_order_relaxed);
+        entry.failures = slot->failures.load(std::memory_order_relaxed);
+        entry.outstanding = slot->outstanding.load(std::memory_order_relaxed);
+        entry.peak_outstanding = slot->peak_outstanding.load(std::memory_order_relaxed);
+        entry.state = slot->channel->GetState(false);
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+void ChannelPool::ResetStats() {
+    for (auto& slot : slots_) {
+        slot->calls.store(0, std::memory_order_relaxed);
+        slot->failures.store(0, std::memory_order_relaxed);
+        slot->peak_outstanding.store(slot->outstanding.load(std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,504 @@
+#include "column_encoder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Protobuf wire types
+constexpr uint32_t WIRETYPE_VARINT = 0;
+constexpr uint32_t WIRETYPE_FIXED64 = 1;
+constexpr uint32_t WIRETYPE_LENGTH_DELIMITED = 2;
+constexpr uint32_t WIRETYPE_FIXED32 = 5;
+
+// DataColumn / DataValue field numbers from common.proto
+constexpr uint32_t DATACOLUMN_NAME = 1;
+constexpr uint32_t DATACOLUMN_DATAVALUES = 2;
+constexpr uint32_t DATAVALUE_UINTVALUE = 3;
+constexpr uint32_t DATAVALUE_ULONGVALUE = 4;
+constexpr uint32_t DATAVALUE_INTVALUE = 5;
+constexpr uint32_t DATAVALUE_LONGVALUE = 6;
+constexpr uint32_t DATAVALUE_FLOATVALUE = 7;
+constexpr uint32_t DATAVALUE_DOUBLEVALUE = 8;
+constexpr uint32_t DATAVALUE_STRINGVALUE = 1;
+constexpr uint32_t DATAVALUE_BYTEARRAYVALUE = 9;
+constexpr uint32_t DATAVALUE_STRUCTUREVALUE = 11;
+
+// Structure / Structure.Field field numbers
+constexpr uint32_t STRUCTURE_FIELDS = 1;
+constexpr uint32_t FIELD_NAME = 1;
+constexpr uint32_t FIELD_VALUE = 2;
+
+// A double DataValue is always tag(doubleValue) + 8 bytes, so every sample
+// encodes to the same 11 bytes: [dataValues tag][len=9][doubleValue tag][fixed64]
+constexpr size_t DOUBLE_VALUE_PAYLOAD = 1 + 8;
+constexpr size_t DOUBLE_SAMPLE_BYTES = 1 + 1 + DOUBLE_VALUE_PAYLOAD;
+
+// Likewise a float DataValue is tag(floatValue) + 4 bytes
+constexpr size_t FLOAT_VALUE_PAYLOAD = 1 + 4;
+constexpr size_t FLOAT_SAMPLE_BYTES = 1 + 1 + FLOAT_VALUE_PAYLOAD;
+
+// Integer samples are varints of up to 10 bytes; the DataValue length still
+// fits in a single byte
+constexpr size_t MAX_VARINT_SAMPLE_BYTES = 1 + 1 + 1 + 10;
+
+inline void storeFixed64(char* out, double value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits = __builtin_bswap64(bits);
+    std::memcpy(out, &bits, sizeof(bits));
+#else
+    std::memcpy(out, &value, sizeof(value));  // Wire format is little-endian
+#endif
+}
+
+inline void storeFixed32(char* out, float value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits = __builtin_bswap32(bits);
+    std::memcpy(out, &bits, sizeof(bits));
+#else
+    std::memcpy(out, &value, sizeof(value));
+#endif
+}
+
+size_t columnNameSize(size_t name_length) {
+    return name_length > 0 ? 1 + ColumnEncoder::VarintSize(name_length) + name_length : 0;
+}
+
+// proto3 omits an empty string field
+char* writeColumnName(char* p, const std::string& name) {
+    if (!name.empty()) {
+        p = ColumnEncoder::WriteTag(p, DATACOLUMN_NAME, WIRETYPE_LENGTH_DELIMITED);
+        p = ColumnEncoder::WriteVarint(p, name.size());
+        std::memcpy(p, name.data(), name.size());
+        p += name.size();
+    }
+    return p;
+}
+
+// Varint-valued column: `wire` maps a sample to the varint it is sent as
+template<typename T, typename WireValue>
+void appendVarintColumn(std::string& out, const std::string& name, const T* values,
+                        size_t count, uint32_t field_number, WireValue wire) {
+    const size_t start = out.size();
+    out.resize(start + columnNameSize(name.size()) + count * MAX_VARINT_SAMPLE_BYTES);
+    char* p = writeColumnName(&out[start], name);
+
+    const char data_values_tag =
+        static_cast<char>((DATACOLUMN_DATAVALUES << 3) | WIRETYPE_LENGTH_DELIMITED);
+    const char value_tag = static_cast<char>((field_number << 3) | WIRETYPE_VARINT);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t value = wire(values[i]);
+        *p++ = data_values_tag;
+        *p++ = static_cast<char>(1 + ColumnEncoder::VarintSize(value));
+        *p++ = value_tag;
+        p = ColumnEncoder::WriteVarint(p, value);
+    }
+    out.resize(p - out.data());
+}
+
+// ========== Sparse Column Layout ==========
+// Every tag in the sparse schema has a field number below 16, so tags are
+// one byte and a length-delimited field is tag + varint length + payload
+
+size_t delimitedSize(size_t length) {
+    return 1 + ColumnEncoder::VarintSize(length) + length;
+}
+
+char* writeDelimitedHeader(char* p, uint32_t field_number, size_t length) {
+    p = ColumnEncoder::WriteTag(p, field_number, WIRETYPE_LENGTH_DELIMITED);
+    return ColumnEncoder::WriteVarint(p, length);
+}
+
+char* writeDelimited(char* p, uint32_t field_number, const char* data, size_t length) {
+    p = writeDelimitedHeader(p, field_number, length);
+    std::memcpy(p, data, length);
+    return p + length;
+}
+
+// Structure.Field message holding a DataValue of `value_size` bytes
+size_t fieldSize(const char* name, size_t value_size) {
+    return delimitedSize(std::strlen(name)) + delimitedSize(value_size);
+}
+
+// Everything of a Structure.Field entry up to the DataValue's own fields
+char* writeFieldHeader(char* p, const char* name, size_t value_size) {
+    p = writeDelimitedHeader(p, STRUCTURE_FIELDS, fieldSize(name, value_size));
+    p = writeDelimited(p, FIELD_NAME, name, std::strlen(name));
+    return writeDelimitedHeader(p, FIELD_VALUE, value_size);
+}
+
+// Sizes of the nested messages of one sparse column
+struct SparseLayout {
+    size_t count;
+    size_t valid;
+    size_t element_size;
+    const char* type_name;
+
+    size_t bitmapBytes() const { return (count + 7) / 8; }
+    size_t valueBytes() const { return valid * element_size; }
+
+    // DataValue messages of the five fields
+    size_t encodingValue() const { return delimitedSize(std::strlen(ColumnEncoder::SPARSE_ENCODING)); }
+    size_t countValue() const { return 1 + ColumnEncoder::VarintSize(count); }
+    size_t typeValue() const { return delimitedSize(std::strlen(type_name)); }
+    size_t validityValue() const { return delimitedSize(bitmapBytes()); }
+    size_t valuesValue() const { return delimitedSize(valueBytes()); }
+
+    size_t structureSize() const {
+        return delimitedSize(fieldSize("encoding", encodingValue())) +
+               delimitedSize(fieldSize("count", countValue())) +
+               delimitedSize(fieldSize("valueType", typeValue())) +
+               delimitedSize(fieldSize("validity", validityValue())) +
+               delimitedSize(fieldSize("values", valuesValue()));
+    }
+    size_t dataValueSize() const { return delimitedSize(structureSize()); }
+    size_t columnSize(size_t name_length) const {
+        return columnNameSize(name_length) + delimitedSize(dataValueSize());
+    }
+};
+
+inline void storeSample(char* out, double value) { storeFixed64(out, value); }
+inline void storeSample(char* out, float value) { storeFixed32(out, value); }
+
+template<typename T>
+const char* sparseTypeName();
+template<> const char* sparseTypeName<double>() { return "double"; }
+template<> const char* sparseTypeName<float>() { return "float"; }
+
+template<typename T>
+void appendSparseColumn(std::string& out, const std::string& name, const T* values, size_t count) {
+    size_t valid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        valid += !std::isnan(values[i]);
+    }
+    const SparseLayout layout{count, valid, sizeof(T), sparseTypeName<T>()};
+
+    const size_t start = out.size();
+    out.resize(start + layout.columnSize(name.size()));
+    char* p = writeColumnName(&out[start], name);
+    p = writeDelimitedHeader(p, DATACOLUMN_DATAVALUES, layout.dataValueSize());
+    p = writeDelimitedHeader(p, DATAVALUE_STRUCTUREVALUE, layout.structureSize());
+
+    p = writeFieldHeader(p, "encoding", layout.encodingValue());
+    p = writeDelimited(p, DATAVALUE_STRINGVALUE, ColumnEncoder::SPARSE_ENCODING,
+                       std::strlen(ColumnEncoder::SPARSE_ENCODING));
+    p = writeFieldHeader(p, "count", layout.countValue());
+    p = ColumnEncoder::WriteTag(p, DATAVALUE_ULONGVALUE, WIRETYPE_VARINT);
+    p = ColumnEncoder::WriteVarint(p, count);
+    p = writeFieldHeader(p, "valueType", layout.typeValue());
+    p = writeDelimited(p, DATAVALUE_STRINGVALUE, layout.type_name, std::strlen(layout.type_name));
+
+    // The bitmap and the packed values are filled in one pass below
+    p = writeFieldHeader(p, "validity", layout.validityValue());
+    p = writeDelimitedHeader(p, DATAVALUE_BYTEARRAYVALUE, layout.bitmapBytes());
+    char* bitmap = p;
+    p += layout.bitmapBytes();
+    p = writeFieldHeader(p, "values", layout.valuesValue());
+    p = writeDelimitedHeader(p, DATAVALUE_BYTEARRAYVALUE, layout.valueBytes());
+    char* packed = p;
+
+    for (size_t byte = 0; byte < layout.bitmapBytes(); ++byte) {
+        const size_t end = std::min(count, byte * 8 + 8);
+        uint8_t bits = 0;
+        for (size_t i = byte * 8; i < end; ++i) {
+            if (!std::isnan(values[i])) {
+                bits |= static_cast<uint8_t>(1u << (i & 7));
+                storeSample(packed, values[i]);
+                packed += sizeof(T);
+            }
+        }
+        bitmap[byte] = static_cast<char>(bits);
+    }
+}
+
+template<typename T>
+T loadSample(const char* in) {
+    T value;
+    std::memcpy(&value, in, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if constexpr (sizeof(T) == 8) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = __builtin_bswap64(bits);
+        std::memcpy(&value, &bits, sizeof(bits));
+    } else {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = __builtin_bswap32(bits);
+        std::memcpy(&value, &bits, sizeof(bits));
+    }
+#endif
+    return value;
+}
+
+template<typename T, typename Set>
+void expandSparse(const std::string& bitmap, const std::string& packed, size_t count,
+                  DataColumn& dense, Set set) {
+    const T missing = std::numeric_limits<T>::quiet_NaN();
+    const char* next = packed.data();
+    auto* out = dense.mutable_datavalues();
+    out->Reserve(static_cast<int>(count));
+    for (size_t i = 0; i < count; ++i) {
+        DataValue* value = out->Add();
+        if (static_cast<uint8_t>(bitmap[i / 8]) & (1u << (i & 7))) {
+            set(*value, loadSample<T>(next));
+            next += sizeof(T);
+        } else {
+            set(*value, missing);
+        }
+    }
+}
+
+template<typename T, typename Append>
+SerializedDataColumn encodeSerialized(const std::string& name, const T* values, size_t count,
+                                      Append append) {
+    SerializedDataColumn serialized;
+    serialized.set_columnname(name);
+    append(*serialized.mutable_serializeddata(), name, values, count);
+    return serialized;
+}
+
+} // namespace
+
+// ========== Wire Format Primitives ==========
+
+size_t ColumnEncoder::VarintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+char* ColumnEncoder::WriteVarint(char* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<char>(value);
+    return out;
+}
+
+char* ColumnEncoder::WriteTag(char* out, uint32_t field_number, uint32_t wire_type) {
+    return WriteVarint(out, (static_cast<uint64_t>(field_number) << 3) | wire_type);
+}
+
+// ========== Double Columns ==========
+
+size_t ColumnEncoder::EncodedDoubleColumnSize(size_t name_length, size_t count) {
+    return columnNameSize(name_length) + count * DOUBLE_SAMPLE_BYTES;
+}
+
+void ColumnEncoder::AppendDoubleColumn(std::string& out, const std::string& name,
+                                       const double* values, size_t count) {
+    const size_t start = out.size();
+    out.resize(start + EncodedDoubleColumnSize(name.size(), count));
+    char* p = writeColumnName(&out[start], name);
+
+    // All three prefix bytes are single-byte varints, so write them directly
+    const char sample_prefix[3] = {
+        static_cast<char>((DATACOLUMN_DATAVALUES << 3) | WIRETYPE_LENGTH_DELIMITED),
+        static_cast<char>(DOUBLE_VALUE_PAYLOAD),
+        static_cast<char>((DATAVALUE_DOUBLEVALUE << 3) | WIRETYPE_FIXED64)
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(p, sample_prefix, sizeof(sample_prefix));
+        storeFixed64(p + sizeof(sample_prefix), values[i]);
+        p += DOUBLE_SAMPLE_BYTES;
+    }
+}
+
+std::string ColumnEncoder::EncodeDoubleColumn(const std::string& name,
+                                              const double* values, size_t count) {
+    std::string out;
+    AppendDoubleColumn(out, name, values, count);
+    return out;
+}
+
+SerializedDataColumn ColumnEncoder::EncodeSerializedColumn(const std::string& name,
+                                                           const double* values, size_t count) {
+    SerializedDataColumn serialized;
+    serialized.set_columnname(name);
+    AppendDoubleColumn(*serialized.mutable_serializeddata(), name, values, count);
+    return serialized;
+}
+
+// ========== Typed Columns ==========
+
+size_t ColumnEncoder::EncodedFloatColumnSize(size_t name_length, size_t count) {
+    return columnNameSize(name_length) + count * FLOAT_SAMPLE_BYTES;
+}
+
+void ColumnEncoder::AppendFloatColumn(std::string& out, const std::string& name,
+                                      const float* values, size_t count) {
+    const size_t start = out.size();
+    out.resize(start + EncodedFloatColumnSize(name.size(), count));
+    char* p = writeColumnName(&out[start], name);
+
+    const char sample_prefix[3] = {
+        static_cast<char>((DATACOLUMN_DATAVALUES << 3) | WIRETYPE_LENGTH_DELIMITED),
+        static_cast<char>(FLOAT_VALUE_PAYLOAD),
+        static_cast<char>((DATAVALUE_FLOATVALUE << 3) | WIRETYPE_FIXED32)
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(p, sample_prefix, sizeof(sample_prefix));
+        storeFixed32(p + sizeof(sample_prefix), values[i]);
+        p += FLOAT_SAMPLE_BYTES;
+    }
+}
+
+void ColumnEncoder::AppendIntColumn(std::string& out, const std::string& name,
+                                    const int32_t* values, size_t count) {
+    appendVarintColumn(out, name, values, count, DATAVALUE_INTVALUE, [](int32_t v) {
+        return static_cast<uint64_t>((static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31));
+    });
+}
+
+void ColumnEncoder::AppendLongColumn(std::string& out, const std::string& name,
+                                     const int64_t* values, size_t count) {
+    appendVarintColumn(out, name, values, count, DATAVALUE_LONGVALUE, [](int64_t v) {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    });
+}
+
+void ColumnEncoder::AppendUIntColumn(std::string& out, const std::string& name,
+                                     const uint32_t* values, size_t count) {
+    appendVarintColumn(out, name, values, count, DATAVALUE_UINTVALUE,
+                       [](uint32_t v) { return static_cast<uint64_t>(v); });
+}
+
+void ColumnEncoder::AppendULongColumn(std::string& out, const std::string& name,
+                                      const uint64_t* values, size_t count) {
+    appendVarintColumn(out, name, values, count, DATAVALUE_ULONGVALUE,
+                       [](uint64_t v) { return v; });
+}
+
+SerializedDataColumn ColumnEncoder::EncodeSerializedColumn(const std::string& name,
+                                                           const float* values, size_t count) {
+    return encodeSerialized(name, values, count, AppendFloatColumn);
+}
+
+SerializedDataColumn ColumnEncoder::EncodeSerializedColumn(const std::string& name,
+                                                           const int32_t* values, size_t count) {
+    return encodeSerialized(name, values, count, AppendIntColumn);
+}
+
+SerializedDataColumn ColumnEncoder::EncodeSerializedColumn(const std::string& name,
+                                                           const int64_t* values, size_t count) {
+    return encodeSerialized(name, values, count, AppendLongColumn);
+}
+
+SerializedDataColumn ColumnEncoder::EncodeSerializedColumn(const std::string& name,
+                                                           const uint32_t* values, size_t count) {
+    return encodeSerialized(name, values, count, AppendUIntColumn);
+}
+
+SerializedDataColumn ColumnEncoder::EncodeSerializedColumn(const std::string& name,
+                                                           const uint64_t* values, size_t count) {
+    return encodeSerialized(name, values, count, AppendULongColumn);
+}
+
+// ========== Sparse Columns ==========
+
+size_t ColumnEncoder::EncodedSparseColumnSize(size_t name_length, size_t count,
+                                              size_t valid, size_t element_size) {
+    // Only the length of the type name matters for the size
+    const char* type_name = element_size == sizeof(float) ? "float" : "double";
+    return SparseLayout{count, valid, element_size, type_name}.columnSize(name_length);
+}
+
+bool ColumnEncoder::SparseIsSmaller(size_t count, size_t nan_count, size_t element_size) {
+    size_t dense = element_size == sizeof(float) ? EncodedFloatColumnSize(0, count)
+                                                 : EncodedDoubleColumnSize(0, count);
+    return EncodedSparseColumnSize(0, count, count - nan_count, element_size) < dense;
+}
+
+void ColumnEncoder::AppendSparseColumn(std::string& out, const std::string& name,
+                                       const double* values, size_t count) {
+    appendSparseColumn(out, name, values, count);
+}
+
+void ColumnEncoder::AppendSparseColumn(std::string& out, const std::string& name,
+                                       const float* values, size_t count) {
+    appendSparseColumn(out, name, values, count);
+}
+
+SerializedDataColumn ColumnEncoder::EncodeSparseSerializedColumn(const std::string& name,
+                                                                 const double* values, size_t count) {
+    return encodeSerialized(name, values, count,
+        static_cast<void (*)(std::string&, const std::string&, const double*, size_t)>(AppendSparseColumn));
+}
+
+SerializedDataColumn ColumnEncoder::EncodeSparseSerializedColumn(const std::string& name,
+                                                                 const float* values, size_t count) {
+    return encodeSerialized(name, values, count,
+        static_cast<void (*)(std::string&, const std::string&, const float*, size_t)>(AppendSparseColumn));
+}
+
+bool ColumnEncoder::IsSparseColumn(const DataColumn& column) {
+    if (column.datavalues_size() != 1 || !column.datavalues(0).has_structurevalue()) {
+        return false;
+    }
+    const Structure& structure = column.datavalues(0).structurevalue();
+    return structure.fields_size() > 0 && structure.fields(0).name() == "encoding" &&
+           structure.fields(0).value().stringvalue() == SPARSE_ENCODING;
+}
+
+bool ColumnEncoder::DecodeSparseColumn(const DataColumn& sparse, DataColumn& dense) {
+    if (!IsSparseColumn(sparse)) {
+        return false;
+    }
+
+    const DataValue* count_value = nullptr;
+    const DataValue* type_value = nullptr;
+    const DataValue* validity_value = nullptr;
+    const DataValue* values_value = nullptr;
+    for (const auto& field : sparse.datavalues(0).structurevalue().fields()) {
+        if (field.name() == "count") count_value = &field.value();
+        else if (field.name() == "valueType") type_value = &field.value();
+        else if (field.name() == "validity") validity_value = &field.value();
+        else if (field.name() == "values") values_value = &field.value();
+    }
+    if (!count_value || !type_value || !validity_value || !values_value) {
+        return false;
+    }
+
+    const size_t count = count_value->ulongvalue();
+    const std::string& type = type_value->stringvalue();
+    const std::string& bitmap = validity_value->bytearrayvalue();
+    const std::string& packed = values_value->bytearrayvalue();
+    size_t element_size = type == "double" ? sizeof(double) : type == "float" ? sizeof(float) : 0;
+    if (element_size == 0 || bitmap.size() != (count + 7) / 8) {
+        return false;
+    }
+
+    // The packed values must match the bitmap exactly (bits past `count` are ignored)
+    size_t valid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        valid += (static_cast<uint8_t>(bitmap[i / 8]) >> (i & 7)) & 1u;
+    }
+    if (packed.size() != valid * element_size) {
+        return false;
+    }
+
+    DataColumn result;
+    result.set_name(sparse.name());
+    if (element_size == sizeof(double)) {
+        expandSparse<double>(bitmap, packed, count, result,
+                             [](DataValue& value, double v) { value.set_doublevalue(v); });
+    } else {
+        expandSparse<float>(bitmap, packed, count, result,
+                            [](DataValue& value, float v) { value.set_floatvalue(v); });
+    }
+    dense = std::move(result);
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "common_client.hpp"
+#include "column_codec.hpp"
 #include <google/protobuf/util/json_util.h>
 #include <google/protobuf/text_format.h>
 #include <sstream>
@@ -258,6 +259,36 @@ DataTimestamps CommonClient::CreateDataTimestampsFromList(const TimestampList& l
     return dt;
 }
 
+namespace {
+
+void fillRunTimestamps(DataTimestamps& dt, const uint64_t* epoch_nanos, const TimestampRun& run) {
+    const uint64_t* first = epoch_nanos + run.first;
+    if (run.isRegular()) {
+        SamplingClock* clock = dt.mutable_samplingclock();
+        clock->mutable_starttime()->set_epochseconds(first[0] / 1000000000ULL);
+        clock->mutable_starttime()->set_nanoseconds(first[0] % 1000000000ULL);
+        clock->set_periodnanos(run.period_nanos);
+        clock->set_count(static_cast<uint32_t>(run.count));
+        return;
+    }
+    auto* timestamps = dt.mutable_timestamplist()->mutable_timestamps();
+    timestamps->Reserve(static_cast<int>(run.count));
+    for (uint64_t i = 0; i < run.count; ++i) {
+        Timestamp* ts = timestamps->Add();
+        ts->set_epochseconds(first[i] / 1000000000ULL);
+        ts->set_nanoseconds(first[i] % 1000000000ULL);
+    }
+}
+
+} // namespace
+
+DataTimestamps CommonClient::CreateDataTimestampsForRun(const uint64_t* epoch_nanos,
+                                                        const TimestampRun& run) {
+    DataTimestamps dt;
+    fillRunTimestamps(dt, epoch_nanos, run);
+    return dt;
+}
+
 bool CommonClient::HasSamplingClock(const DataTimestamps& dt) {
     return dt.has_samplingclock();
 }
@@ -749,6 +780,82 @@ bool CommonClient::IsValidImageType(const Image& image) {
            image.filetype() <= Image_FileType_PDF;
 }
 
+// ========== Arena Operations ==========
+
+Attribute* CommonClient::CreateAttribute(google::protobuf::Arena* arena,
+                                         const std::string& name, const std::string& value) {
+    auto* attr = google::protobuf::Arena::CreateMessage<Attribute>(arena);
+    attr->set_name(name);
+    attr->set_value(value);
+    return attr;
+}
+
+Timestamp* CommonClient::CreateTimestamp(google::protobuf::Arena* arena,
+                                         uint64_t epochSeconds, uint64_t nanoseconds) {
+    auto* ts = google::protobuf::Arena::CreateMessage<Timestamp>(arena);
+    ts->set_epochseconds(epochSeconds);
+    ts->set_nanoseconds(nanoseconds);
+    return ts;
+}
+
+EventMetadata* CommonClient::CreateEventMetadata(google::protobuf::Arena* arena,
+                                                 const std::string& description,
+                                                 const Timestamp& start,
+                                                 const Timestamp& stop) {
+    auto* event = google::protobuf::Arena::CreateMessage<EventMetadata>(arena);
+    event->set_description(description);
+    *event->mutable_starttimestamp() = start;
+    *event->mutable_stoptimestamp() = stop;
+    return event;
+}
+
+SamplingClock* CommonClient::CreateSamplingClock(google::protobuf::Arena* arena,
+                                                 const Timestamp& startTime,
+                                                 uint64_t periodNanos,
+                                                 uint32_t count) {
+    auto* clock = google::protobuf::Arena::CreateMessage<SamplingClock>(arena);
+    *clock->mutable_starttime() = startTime;
+    clock->set_periodnanos(periodNanos);
+    clock->set_count(count);
+    return clock;
+}
+
+DataTimestamps* CommonClient::CreateDataTimestampsFromClock(google::protobuf::Arena* arena,
+                                                            const SamplingClock& clock) {
+    auto* dt = google::protobuf::Arena::CreateMessage<DataTimestamps>(arena);
+    *dt->mutable_samplingclock() = clock;
+    return dt;
+}
+
+DataTimestamps* CommonClient::CreateDataTimestampsForRun(google::protobuf::Arena* arena,
+                                                         const uint64_t* epoch_nanos,
+                                                         const TimestampRun& run) {
+    auto* dt = google::protobuf::Arena::CreateMessage<DataTimestamps>(arena);
+    fillRunTimestamps(*dt, epoch_nanos, run);
+    return dt;
+}
+
+DataValue* CommonClient::CreateDoubleValue(google::protobuf::Arena* arena, double value) {
+    auto* dv = google::protobuf::Arena::CreateMessage<DataValue>(arena);
+    dv->set_doublevalue(value);
+    return dv;
+}
+
+DataColumn* CommonClient::CreateDataColumn(google::protobuf::Arena* arena,
+                                           const std::string& name,
+                                           const double* values, size_t count) {
+    auto* column = google::protobuf::Arena::CreateMessage<DataColumn>(arena);
+    column->set_name(name);
+    
+    // Values are created in place on the column's arena, no intermediate copies
+    auto* data_values = column->mutable_datavalues();
+    data_values->Reserve(static_cast<int>(count));
+    for (size_t i = 0; i < count; ++i) {
+        data_values->Add()->set_doublevalue(values[i]);
+    }
+    return column;
+}
+
 // ========== SerializedDataColumn Operations ==========
 
 SerializedDataColumn CommonClient::SerializeDataColumn(const DataColumn& column) {
@@ -780,6 +887,44 @@ size_t CommonClient::GetSerializedSize(const SerializedDataColumn& serialized) {
     return serialized.serializeddata().size();
 }
 
+// ========== Compressed Column Operations ==========
+
+DataColumn CommonClient::EncodeColumn(const std::string& name, const std::vector<double>& values) {
+    DataColumn column;
+    column.set_name(name);
+    ColumnCodec::AppendDoubles(values.data(), values.size(),
+                               *column.add_datavalues()->mutable_bytearrayvalue());
+    return column;
+}
+
+DataColumn CommonClient::EncodeColumn(const std::string& name, const std::vector<uint64_t>& values) {
+    DataColumn column;
+    column.set_name(name);
+    ColumnCodec::AppendIntegers(values.data(), values.size(),
+                                *column.add_datavalues()->mutable_bytearrayvalue());
+    return column;
+}
+
+bool CommonClient::IsEncodedColumn(const DataColumn& column) {
+    return column.datavalues_size() == 1 &&
+           column.datavalues(0).value_case() == DataValue::kByteArrayValue &&
+           ColumnCodec::Identify(column.datavalues(0).bytearrayvalue()) != ColumnCodec::Codec::NONE;
+}
+
+bool CommonClient::DecodeColumn(const DataColumn& column, std::vector<double>& values) {
+    if (!IsEncodedColumn(column)) {
+        return false;
+    }
+    return ColumnCodec::DecodeDoubles(column.datavalues(0).bytearrayvalue(), values);
+}
+
+bool CommonClient::DecodeColumn(const DataColumn& column, std::vector<uint64_t>& values) {
+    if (!IsEncodedColumn(column)) {
+        return false;
+    }
+    return ColumnCodec::DecodeIntegers(column.datavalues(0).bytearrayvalue(), values);
+}
+
 // ========== Utility Operations ==========
 
 std::string CommonClient::SerializeToString(const google::protobuf::Message& message) {
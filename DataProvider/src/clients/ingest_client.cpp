@@ -2,7 +2,14 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <algorithm>
 #include <sstream>
+#include <cstring>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/unknown_field_set.h>
 
 // ========== StreamIngestionSession Implementation ==========
 
@@ -10,17 +17,20 @@ class IngestionClient::StreamIngestionSession::Impl {
 public:
     std::shared_ptr<grpc::ClientWriter<IngestDataRequest>> writer;
     std::shared_ptr<grpc::ClientContext> context;
+    std::shared_ptr<IngestDataStreamResponse> response;  // Filled in by the server on Finish()
     std::vector<std::string> sent_request_ids;
     
     Impl(std::shared_ptr<grpc::ClientWriter<IngestDataRequest>> w,
-         std::shared_ptr<grpc::ClientContext> ctx)
-        : writer(w), context(ctx) {}
+         std::shared_ptr<grpc::ClientContext> ctx,
+         std::shared_ptr<IngestDataStreamResponse> resp)
+        : writer(w), context(ctx), response(resp) {}
 };
 
 IngestionClient::StreamIngestionSession::StreamIngestionSession(
     std::shared_ptr<grpc::ClientWriter<IngestDataRequest>> writer,
-    std::shared_ptr<grpc::ClientContext> context)
-    : pImpl(std::make_unique<Impl>(writer, context)) {}
+    std::shared_ptr<grpc::ClientContext> context,
+    std::shared_ptr<IngestDataStreamResponse> response)
+    : pImpl(std::make_unique<Impl>(writer, context, response)) {}
 
 bool IngestionClient::StreamIngestionSession::SendData(const IngestDataRequest& request) {
     if (!pImpl->writer) return false;
@@ -52,6 +62,10 @@ IngestDataStreamResponse IngestionClient::StreamIngestionSession::Finish() {
         pImpl->writer->WritesDone();
         grpc::Status status = pImpl->writer->Finish();
         
+        if (status.ok() && pImpl->response) {
+            response = *pImpl->response;
+        }
+        
         // Response should be populated by the server
         // If not, we create a basic response
         if (!status.ok()) {
@@ -130,6 +144,230 @@ std::vector<IngestDataResponse> IngestionClient::BidiStreamIngestionSession::Rea
     return responses;
 }
 
+// ========== BulkIngestionSession Implementation ==========
+
+class IngestionClient::BulkIngestionSession::Impl {
+public:
+    struct PendingRequest {
+        uint64_t sequence;
+        AckCallback on_ack;
+    };
+    
+    std::shared_ptr<grpc::ClientReaderWriter<IngestDataRequest, IngestDataResponse>> stream;
+    std::shared_ptr<grpc::ClientContext> context;
+    size_t max_in_flight;
+    
+    // Outstanding requests keyed by clientRequestId. A multimap so duplicate
+    // ids from careless callers still get exactly one callback each.
+    std::unordered_multimap<std::string, PendingRequest> pending;
+    uint64_t next_sequence = 0;
+    bool stream_ended = false;
+    grpc::Status final_status;
+    BulkStats stats;
+    std::string last_error;
+    mutable std::mutex mutex;
+    std::condition_variable window_cv;
+    
+    std::mutex write_mutex;  // Only one Write may be outstanding on a stream
+    bool writes_done = false;
+    std::thread reader;
+    
+    Impl(std::shared_ptr<grpc::ClientReaderWriter<IngestDataRequest, IngestDataResponse>> s,
+         std::shared_ptr<grpc::ClientContext> ctx,
+         size_t window)
+        : stream(s), context(ctx), max_in_flight(std::max<size_t>(1, window)) {
+        reader = std::thread([this] { ReadLoop(); });
+    }
+    
+    static IngestDataResponse MakeFailure(const std::string& client_request_id,
+                                          const std::string& message) {
+        IngestDataResponse response;
+        response.set_clientrequestid(client_request_id);
+        auto* exceptional = response.mutable_exceptionalresult();
+        exceptional->set_exceptionalresultstatus(
+            ExceptionalResult_ExceptionalResultStatus_RESULT_STATUS_ERROR);
+        exceptional->set_message(message);
+        return response;
+    }
+    
+    void ReadLoop() {
+        IngestDataResponse response;
+        while (stream->Read(&response)) {
+            AckCallback on_ack;
+            bool matched = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto it = pending.find(response.clientrequestid());
+                if (it != pending.end()) {
+                    on_ack = std::move(it->second.on_ack);
+                    pending.erase(it);
+                    matched = true;
+                    if (response.has_ackresult()) {
+                        stats.requests_acked++;
+                    } else {
+                        stats.requests_rejected++;
+                        if (response.has_exceptionalresult()) {
+                            last_error = response.exceptionalresult().message();
+                        }
+                    }
+                } else {
+                    stats.unmatched_responses++;
+                }
+            }
+            
+            if (matched) {
+                window_cv.notify_all();
+                if (on_ack) on_ack(response);
+            }
+        }
+        
+        grpc::Status status = stream->Finish();
+        
+        // Anything still pending will never be answered
+        std::unordered_multimap<std::string, PendingRequest> orphaned;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            final_status = status;
+            stream_ended = true;
+            if (!status.ok()) {
+                last_error = status.error_message();
+            }
+            stats.requests_failed += pending.size();
+            orphaned.swap(pending);
+        }
+        window_cv.notify_all();
+        
+        std::string message = status.ok() ? "Stream closed before acknowledgment"
+                                          : status.error_message();
+        for (auto& [request_id, entry] : orphaned) {
+            if (entry.on_ack) entry.on_ack(MakeFailure(request_id, message));
+        }
+    }
+    
+    // Fail a request whose Write did not go through, unless the reader got to it first
+    void FailRequest(const std::string& request_id, uint64_t sequence, const std::string& message) {
+        AckCallback on_ack;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto range = pending.equal_range(request_id);
+            auto it = std::find_if(range.first, range.second,
+                [sequence](const auto& entry) { return entry.second.sequence == sequence; });
+            if (it == range.second) {
+                return;
+            }
+            on_ack = std::move(it->second.on_ack);
+            pending.erase(it);
+            stats.requests_failed++;
+            last_error = message;
+        }
+        window_cv.notify_all();
+        if (on_ack) on_ack(MakeFailure(request_id, message));
+    }
+    
+    void CloseWrites() {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        if (!writes_done) {
+            stream->WritesDone();
+            writes_done = true;
+        }
+    }
+    
+    void JoinReader() {
+        if (reader.joinable()) {
+            reader.join();
+        }
+    }
+};
+
+IngestionClient::BulkIngestionSession::BulkIngestionSession(
+    std::shared_ptr<grpc::ClientReaderWriter<IngestDataRequest, IngestDataResponse>> stream,
+    std::shared_ptr<grpc::ClientContext> context,
+    size_t max_in_flight)
+    : pImpl(std::make_unique<Impl>(stream, context, max_in_flight)) {}
+
+IngestionClient::BulkIngestionSession::~BulkIngestionSession() {
+    pImpl->CloseWrites();
+    pImpl->JoinReader();
+}
+
+bool IngestionClient::BulkIngestionSession::Send(const IngestDataRequest& request, AckCallback on_ack) {
+    const std::string& request_id = request.clientrequestid();
+    uint64_t sequence;
+    {
+        std::unique_lock<std::mutex> lock(pImpl->mutex);
+        pImpl->window_cv.wait(lock, [this] {
+            return pImpl->stream_ended || pImpl->pending.size() < pImpl->max_in_flight;
+        });
+        
+        if (pImpl->stream_ended) {
+            lock.unlock();
+            if (on_ack) on_ack(Impl::MakeFailure(request_id, "Bulk ingestion stream is closed"));
+            return false;
+        }
+        
+        sequence = pImpl->next_sequence++;
+        pImpl->pending.emplace(request_id, Impl::PendingRequest{sequence, std::move(on_ack)});
+        pImpl->stats.requests_sent++;
+        pImpl->stats.bytes_sent += request.ByteSizeLong();
+        pImpl->stats.peak_in_flight = std::max(pImpl->stats.peak_in_flight, pImpl->pending.size());
+    }
+    
+    bool written = false;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->write_mutex);
+        written = !pImpl->writes_done && pImpl->stream->Write(request);
+    }
+    
+    if (!written) {
+        pImpl->FailRequest(request_id, sequence, "Failed to write to bulk ingestion stream");
+        return false;
+    }
+    return true;
+}
+
+void IngestionClient::BulkIngestionSession::Flush() {
+    std::unique_lock<std::mutex> lock(pImpl->mutex);
+    pImpl->window_cv.wait(lock, [this] {
+        return pImpl->stream_ended || pImpl->pending.empty();
+    });
+}
+
+bool IngestionClient::BulkIngestionSession::Finish() {
+    pImpl->CloseWrites();
+    pImpl->JoinReader();
+    
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->final_status.ok() &&
+           pImpl->stats.requests_acked == pImpl->stats.requests_sent;
+}
+
+void IngestionClient::BulkIngestionSession::Cancel() {
+    if (pImpl->context) {
+        pImpl->context->TryCancel();
+    }
+}
+
+size_t IngestionClient::BulkIngestionSession::InFlight() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->pending.size();
+}
+
+bool IngestionClient::BulkIngestionSession::IsOpen() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return !pImpl->stream_ended;
+}
+
+IngestionClient::BulkIngestionSession::BulkStats
+IngestionClient::BulkIngestionSession::GetStats() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->stats;
+}
+
+std::string IngestionClient::BulkIngestionSession::GetLastError() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->last_error;
+}
+
 // ========== SubscriptionSession Implementation ==========
 
 class IngestionClient::SubscriptionSession::Impl {
@@ -230,24 +468,149 @@ bool IngestionClient::SubscriptionSession::IsActive() const {
 
 class IngestionClient::Impl {
 public:
-    std::shared_ptr<grpc::Channel> channel;
-    std::unique_ptr<DpIngestionService::Stub> stub;
+    std::unique_ptr<ChannelPool> pool;
+    std::vector<std::unique_ptr<DpIngestionService::Stub>> stubs;  // One per pooled channel
     CommonClient common_client;
     
     int default_timeout_seconds = 30;
+    size_t max_message_bytes = ChannelPool::DEFAULT_MAX_MESSAGE_BYTES;  // Split threshold, 0 = never
     std::string last_error;
     ClientStats stats;
+    mutable std::mutex state_mutex;  // Guards last_error and stats; the stub itself is thread-safe
+    
+    // Async unary calls: one CompletionQueue per poller thread, calls spread
+    // round-robin. The tag handed to gRPC is the AsyncCall itself.
+    struct AsyncCall {
+        grpc::ClientContext context;
+        IngestDataResponse response;
+        grpc::Status status;
+        std::unique_ptr<grpc::ClientAsyncResponseReader<IngestDataResponse>> reader;
+        IngestCallback callback;
+        size_t channel = 0;
+    };
+    
+    std::vector<std::unique_ptr<grpc::CompletionQueue>> async_queues;
+    std::vector<std::thread> async_pollers;
+    std::atomic<size_t> next_async_queue{0};
+    size_t async_max_in_flight = 256;
+    size_t async_in_flight = 0;
+    bool async_started = false;
+    mutable std::mutex async_mutex;
+    std::condition_variable async_cv;
+    
+    explicit Impl(std::unique_ptr<ChannelPool> channel_pool)
+        : pool(std::move(channel_pool)) {
+        for (size_t i = 0; i < pool->Size(); ++i) {
+            stubs.push_back(DpIngestionService::NewStub(pool->GetChannel(i)));
+        }
+        if (pool->GetMaxMessageBytes() != 0) {
+            max_message_bytes = pool->GetMaxMessageBytes();
+        }
+    }
+    
+    bool NeedsSplit(const IngestDataRequest& request) const {
+        return max_message_bytes != 0 && request.ByteSizeLong() > max_message_bytes;
+    }
+    
+    // Streams are only placed by the pool: the open counts as a call, but a
+    // long-lived session is not tracked as outstanding
+    DpIngestionService::Stub& StreamStub() {
+        size_t channel = pool->Acquire();
+        pool->Release(channel, true);
+        return *stubs[channel];
+    }
+    
+    ~Impl() {
+        StopAsync();
+    }
+    
+    void StartAsync(size_t poller_threads, size_t max_in_flight) {
+        std::lock_guard<std::mutex> lock(async_mutex);
+        if (async_started) return;
+        
+        async_max_in_flight = std::max<size_t>(1, max_in_flight);
+        poller_threads = std::max<size_t>(1, poller_threads);
+        for (size_t i = 0; i < poller_threads; ++i) {
+            async_queues.push_back(std::make_unique<grpc::CompletionQueue>());
+        }
+        for (auto& queue : async_queues) {
+            async_pollers.emplace_back([this, cq = queue.get()] { PollAsync(cq); });
+        }
+        async_started = true;
+    }
+    
+    // Let outstanding calls finish (their deadlines bound the wait), then
+    // shut the queues down so the pollers drain and exit
+    void StopAsync() {
+        {
+            std::unique_lock<std::mutex> lock(async_mutex);
+            if (!async_started) return;
+            async_cv.wait(lock, [this] { return async_in_flight == 0; });
+        }
+        for (auto& queue : async_queues) {
+            queue->Shutdown();
+        }
+        for (auto& poller : async_pollers) {
+            if (poller.joinable()) poller.join();
+        }
+    }
+    
+    void PollAsync(grpc::CompletionQueue* cq) {
+        void* tag = nullptr;
+        bool ok = false;
+        while (cq->Next(&tag, &ok)) {
+            std::unique_ptr<AsyncCall> call(static_cast<AsyncCall*>(tag));
+            
+            if (!ok || !call->status.ok()) {
+                std::string message = ok ? call->status.error_message()
+                                         : "Async ingestion call did not complete";
+                RecordError(message);
+                if (!call->response.has_exceptionalresult()) {
+                    auto* exceptional = call->response.mutable_exceptionalresult();
+                    exceptional->set_exceptionalresultstatus(
+                        ExceptionalResult_ExceptionalResultStatus_RESULT_STATUS_ERROR);
+                    exceptional->set_message(message);
+                }
+            } else if (call->response.has_ackresult()) {
+                CountStat(&ClientStats::data_ingested);
+            }
+            
+            pool->Release(call->channel, ok && call->status.ok());
+            
+            if (call->callback) {
+                call->callback(call->response);
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(async_mutex);
+                --async_in_flight;
+            }
+            async_cv.notify_all();
+        }
+    }
+    
+    void RecordError(const std::string& message) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        last_error = message;
+        stats.errors++;
+    }
     
-    Impl(std::shared_ptr<grpc::Channel> ch) 
-        : channel(ch), stub(DpIngestionService::NewStub(ch)) {}
+    void CountStat(uint64_t ClientStats::*counter) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        ++(stats.*counter);
+    }
 };
 
 IngestionClient::IngestionClient(std::shared_ptr<grpc::Channel> channel)
-    : pImpl(std::make_unique<Impl>(channel)) {}
+    : pImpl(std::make_unique<Impl>(std::make_unique<ChannelPool>(channel))) {}
 
 IngestionClient::IngestionClient(const std::string& server_address)
+    : pImpl(std::make_unique<Impl>(std::make_unique<ChannelPool>(server_address, 1))) {}
+
+IngestionClient::IngestionClient(const std::string& server_address, size_t channel_count,
+                                 ChannelPool::Policy policy, size_t max_message_bytes)
     : pImpl(std::make_unique<Impl>(
-        grpc::CreateChannel(server_address, grpc::InsecureChannelCredentials()))) {}
+        std::make_unique<ChannelPool>(server_address, channel_count, policy, max_message_bytes))) {}
 
 IngestionClient::~IngestionClient() = default;
 
@@ -262,13 +625,12 @@ std::optional<std::string> IngestionClient::RegisterProvider(
     auto response = RegisterProviderWithDetails(provider_name, description, tags, attributes);
     
     if (response.has_registrationresult()) {
-        pImpl->stats.providers_registered++;
+        pImpl->CountStat(&ClientStats::providers_registered);
         return response.registrationresult().providerid();
     }
     
     if (response.has_exceptionalresult()) {
-        pImpl->last_error = response.exceptionalresult().message();
-        pImpl->stats.errors++;
+        pImpl->RecordError(response.exceptionalresult().message());
     }
     
     return std::nullopt;
@@ -301,11 +663,12 @@ RegisterProviderResponse IngestionClient::RegisterProviderWithDetails(
                    std::chrono::seconds(pImpl->default_timeout_seconds);
     context.set_deadline(deadline);
     
-    grpc::Status status = pImpl->stub->registerProvider(&context, request, &response);
+    ChannelPool::Lease lease(*pImpl->pool);
+    grpc::Status status = pImpl->stubs[lease.Index()]->registerProvider(&context, request, &response);
+    lease.MarkOk(status.ok());
     
     if (!status.ok()) {
-        pImpl->last_error = status.error_message();
-        pImpl->stats.errors++;
+        pImpl->RecordError(status.error_message());
         
         // Create exceptional result if not already present
         if (!response.has_exceptionalresult()) {
@@ -335,13 +698,12 @@ bool IngestionClient::IngestData(
                                           data_frame, tags, attributes, event);
     
     if (response.has_ackresult()) {
-        pImpl->stats.data_ingested++;
+        pImpl->CountStat(&ClientStats::data_ingested);
         return true;
     }
     
     if (response.has_exceptionalresult()) {
-        pImpl->last_error = response.exceptionalresult().message();
-        pImpl->stats.errors++;
+        pImpl->RecordError(response.exceptionalresult().message());
     }
     
     return false;
@@ -372,6 +734,15 @@ IngestDataResponse IngestionClient::IngestDataWithResponse(
         *request.mutable_eventmetadata() = event.value();
     }
     
+    return SendIngestRequest(request);
+}
+
+IngestDataResponse IngestionClient::SendIngestRequest(const IngestDataRequest& request) {
+    // Oversized requests go out as parallel pieces through the async path
+    if (pImpl->NeedsSplit(request)) {
+        return IngestDataAsync(request).get();
+    }
+    
     IngestDataResponse response;
     grpc::ClientContext context;
     
@@ -379,11 +750,12 @@ IngestDataResponse IngestionClient::IngestDataWithResponse(
                    std::chrono::seconds(pImpl->default_timeout_seconds);
     context.set_deadline(deadline);
     
-    grpc::Status status = pImpl->stub->ingestData(&context, request, &response);
+    ChannelPool::Lease lease(*pImpl->pool);
+    grpc::Status status = pImpl->stubs[lease.Index()]->ingestData(&context, request, &response);
+    lease.MarkOk(status.ok());
     
     if (!status.ok()) {
-        pImpl->last_error = status.error_message();
-        pImpl->stats.errors++;
+        pImpl->RecordError(status.error_message());
         
         if (!response.has_exceptionalresult()) {
             auto* exceptional = response.mutable_exceptionalresult();
@@ -396,6 +768,117 @@ IngestDataResponse IngestionClient::IngestDataWithResponse(
     return response;
 }
 
+// ========== Asynchronous Data Ingestion ==========
+
+void IngestionClient::ConfigureAsync(size_t poller_threads, size_t max_in_flight) {
+    pImpl->StartAsync(poller_threads, max_in_flight);
+}
+
+void IngestionClient::IngestDataAsync(const IngestDataRequest& request, IngestCallback callback) {
+    if (pImpl->NeedsSplit(request)) {
+        auto pieces = SplitIngestRequest(request, pImpl->max_message_bytes);
+        if (pieces.size() > 1) {
+            // One response for the caller once every piece has answered: the
+            // first failure, or an ack with the rows of all pieces
+            struct Pending {
+                std::mutex mutex;
+                size_t remaining;
+                uint64_t rows = 0;
+                IngestDataResponse response;
+                IngestCallback callback;
+            };
+            auto pending = std::make_shared<Pending>();
+            pending->remaining = pieces.size();
+            pending->callback = std::move(callback);
+            
+            for (const auto& piece : pieces) {
+                IngestDataAsync(piece, [pending, id = request.clientrequestid()](
+                                           const IngestDataResponse& response) {
+                    bool last;
+                    {
+                        std::lock_guard<std::mutex> lock(pending->mutex);
+                        if (response.has_ackresult()) {
+                            pending->rows += response.ackresult().numrows();
+                            if (!pending->response.has_exceptionalresult()) {
+                                pending->response = response;
+                            }
+                        } else if (!pending->response.has_exceptionalresult()) {
+                            pending->response = response;
+                        }
+                        last = --pending->remaining == 0;
+                    }
+                    if (!last) {
+                        return;
+                    }
+                    pending->response.set_clientrequestid(id);
+                    if (pending->response.has_ackresult()) {
+                        pending->response.mutable_ackresult()->set_numrows(
+                            static_cast<uint32_t>(pending->rows));
+                    }
+                    if (pending->callback) {
+                        pending->callback(pending->response);
+                    }
+                });
+            }
+            return;
+        }
+    }
+    
+    pImpl->StartAsync(2, 256);  // No-op once configured
+    
+    size_t in_flight;
+    {
+        std::unique_lock<std::mutex> lock(pImpl->async_mutex);
+        pImpl->async_cv.wait(lock, [this] {
+            return pImpl->async_in_flight < pImpl->async_max_in_flight;
+        });
+        in_flight = ++pImpl->async_in_flight;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(pImpl->state_mutex);
+        pImpl->stats.async_calls++;
+        pImpl->stats.async_peak_in_flight = std::max(pImpl->stats.async_peak_in_flight, in_flight);
+    }
+    
+    auto call = std::make_unique<Impl::AsyncCall>();
+    call->callback = std::move(callback);
+    call->context.set_deadline(std::chrono::system_clock::now() +
+                               std::chrono::seconds(pImpl->default_timeout_seconds));
+    
+    size_t queue_index = pImpl->next_async_queue.fetch_add(1) % pImpl->async_queues.size();
+    grpc::CompletionQueue* cq = pImpl->async_queues[queue_index].get();
+    call->channel = pImpl->pool->Acquire();
+    
+    // The request is serialized here, so the caller may free it on return
+    call->reader = pImpl->stubs[call->channel]->PrepareAsyncingestData(&call->context, request, cq);
+    call->reader->StartCall();
+    
+    Impl::AsyncCall* tag = call.release();  // Reclaimed by the poller
+    tag->reader->Finish(&tag->response, &tag->status, tag);
+}
+
+std::future<IngestDataResponse> IngestionClient::IngestDataAsync(const IngestDataRequest& request) {
+    auto promise = std::make_shared<std::promise<IngestDataResponse>>();
+    auto future = promise->get_future();
+    
+    IngestDataAsync(request, [promise](const IngestDataResponse& response) {
+        promise->set_value(response);
+    });
+    
+    return future;
+}
+
+void IngestionClient::WaitForAsyncIdle() {
+    std::unique_lock<std::mutex> lock(pImpl->async_mutex);
+    pImpl->async_cv.wait(lock, [this] { return pImpl->async_in_flight == 0; });
+}
+
+size_t IngestionClient::GetAsyncInFlight() const {
+    std::lock_guard<std::mutex> lock(pImpl->async_mutex);
+    return pImpl->async_in_flight;
+}
+
 IngestionDataFrame IngestionClient::CreateDataFrame(
     const DataTimestamps& timestamps,
     const std::vector<DataColumn>& columns) {
@@ -418,6 +901,301 @@ IngestionDataFrame IngestionClient::CreateDataFrameFromClock(
     return CreateDataFrame(timestamps, columns);
 }
 
+IngestionDataFrame* IngestionClient::CreateDataFrame(
+    google::protobuf::Arena* arena,
+    const DataTimestamps& timestamps,
+    const std::vector<DataColumn>& columns) {
+    
+    auto* frame = google::protobuf::Arena::CreateMessage<IngestionDataFrame>(arena);
+    *frame->mutable_datatimestamps() = timestamps;
+    
+    frame->mutable_datacolumns()->Reserve(static_cast<int>(columns.size()));
+    for (const auto& column : columns) {
+        *frame->add_datacolumns() = column;
+    }
+    
+    return frame;
+}
+
+IngestDataRequest* IngestionClient::CreateIngestRequest(
+    google::protobuf::Arena* arena,
+    const std::string& provider_id,
+    const std::string& client_request_id,
+    const std::vector<std::string>& tags,
+    const std::vector<Attribute>& attributes,
+    const std::optional<EventMetadata>& event) {
+    
+    auto* request = google::protobuf::Arena::CreateMessage<IngestDataRequest>(arena);
+    request->set_providerid(provider_id);
+    request->set_clientrequestid(client_request_id);
+    
+    for (const auto& tag : tags) {
+        request->add_tags(tag);
+    }
+    
+    request->mutable_attributes()->Reserve(static_cast<int>(attributes.size()));
+    for (const auto& attr : attributes) {
+        *request->add_attributes() = attr;
+    }
+    
+    if (event.has_value()) {
+        *request->mutable_eventmetadata() = event.value();
+    }
+    
+    return request;
+}
+
+std::vector<IngestionDataFrame> IngestionClient::PackDataFrames(
+    const DataTimestamps& timestamps,
+    std::vector<DataColumn> columns,
+    size_t max_columns,
+    size_t max_bytes) {
+    
+    std::vector<IngestionDataFrame> frames;
+    if (columns.empty()) return frames;
+    
+    max_columns = std::max<size_t>(1, max_columns);
+    
+    // Embedded messages cost a tag byte plus a varint length on top of their payload
+    auto embedded_size = [](size_t payload) {
+        return 1 + google::protobuf::io::CodedOutputStream::VarintSize64(payload) + payload;
+    };
+    const size_t timestamps_bytes = embedded_size(timestamps.ByteSizeLong());
+    
+    IngestionDataFrame frame;
+    size_t frame_bytes = 0;
+    
+    for (auto& column : columns) {
+        size_t column_bytes = embedded_size(column.ByteSizeLong());
+        
+        bool frame_full = frame.datacolumns_size() > 0 &&
+            (static_cast<size_t>(frame.datacolumns_size()) >= max_columns ||
+             frame_bytes + column_bytes > max_bytes);
+        
+        if (frame_full) {
+            frames.push_back(std::move(frame));
+            frame = IngestionDataFrame();
+        }
+        
+        if (frame.datacolumns_size() == 0) {
+            *frame.mutable_datatimestamps() = timestamps;
+            frame_bytes = timestamps_bytes;
+        }
+        
+        *frame.add_datacolumns() = std::move(column);
+        frame_bytes += column_bytes;
+    }
+    
+    frames.push_back(std::move(frame));
+    return frames;
+}
+
+std::vector<std::vector<SerializedDataColumn>> IngestionClient::PackSerializedColumns(
+    const DataTimestamps& timestamps,
+    std::vector<SerializedDataColumn> columns,
+    size_t max_columns,
+    size_t max_bytes) {
+    
+    std::vector<std::vector<SerializedDataColumn>> groups;
+    max_columns = std::max<size_t>(1, max_columns);
+    
+    auto embedded_size = [](size_t payload) {
+        return 1 + google::protobuf::io::CodedOutputStream::VarintSize64(payload) + payload;
+    };
+    const size_t timestamps_bytes = embedded_size(timestamps.ByteSizeLong());
+    size_t group_bytes = 0;
+    
+    for (auto& column : columns) {
+        size_t column_bytes = embedded_size(column.serializeddata().size());
+        
+        bool group_full = !groups.empty() && !groups.back().empty() &&
+            (groups.back().size() >= max_columns || group_bytes + column_bytes > max_bytes);
+        
+        if (groups.empty() || group_full) {
+            groups.emplace_back();
+            group_bytes = timestamps_bytes;
+        }
+        
+        groups.back().push_back(std::move(column));
+        group_bytes += column_bytes;
+    }
+    
+    return groups;
+}
+
+// ========== Message Size ==========
+
+namespace {
+
+// Tag byte plus varint length on top of an embedded message's payload
+size_t embeddedSize(size_t payload) {
+    return 1 + google::protobuf::io::CodedOutputStream::VarintSize64(payload) + payload;
+}
+
+// Samples [first, first + count) of a frame whose columns all match its timestamps
+IngestionDataFrame sliceFrame(const IngestionDataFrame& frame, size_t first, size_t count) {
+    IngestionDataFrame piece;
+    const DataTimestamps& timestamps = frame.datatimestamps();
+    
+    if (timestamps.has_samplingclock()) {
+        const SamplingClock& clock = timestamps.samplingclock();
+        uint64_t start_nanos = clock.starttime().nanoseconds() + first * clock.periodnanos();
+        auto* piece_clock = piece.mutable_datatimestamps()->mutable_samplingclock();
+        piece_clock->mutable_starttime()->set_epochseconds(
+            clock.starttime().epochseconds() + start_nanos / 1000000000ULL);
+        piece_clock->mutable_starttime()->set_nanoseconds(start_nanos % 1000000000ULL);
+        piece_clock->set_periodnanos(clock.periodnanos());
+        piece_clock->set_count(static_cast<uint32_t>(count));
+    } else {
+        const auto& source = timestamps.timestamplist().timestamps();
+        auto* list = piece.mutable_datatimestamps()->mutable_timestamplist()->mutable_timestamps();
+        list->Reserve(static_cast<int>(count));
+        for (size_t i = first; i < first + count; ++i) {
+            *list->Add() = source[static_cast<int>(i)];
+        }
+    }
+    
+    piece.mutable_datacolumns()->Reserve(frame.datacolumns_size());
+    for (const auto& column : frame.datacolumns()) {
+        DataColumn* piece_column = piece.add_datacolumns();
+        piece_column->set_name(column.name());
+        piece_column->mutable_datavalues()->Reserve(static_cast<int>(count));
+        for (size_t i = first; i < first + count; ++i) {
+            *piece_column->add_datavalues() = column.datavalues(static_cast<int>(i));
+        }
+    }
+    return piece;
+}
+
+} // namespace
+
+std::vector<IngestionDataFrame> IngestionClient::SplitDataFrame(
+    const IngestionDataFrame& frame,
+    size_t max_bytes) {
+    
+    const DataTimestamps& timestamps = frame.datatimestamps();
+    const bool has_clock = timestamps.has_samplingclock();
+    const size_t samples = has_clock
+        ? timestamps.samplingclock().count()
+        : static_cast<size_t>(timestamps.timestamplist().timestamps_size());
+    
+    bool columns_match = true;
+    for (const auto& column : frame.datacolumns()) {
+        columns_match &= static_cast<size_t>(column.datavalues_size()) == samples;
+    }
+    if (samples <= 1 || !columns_match || frame.ByteSizeLong() <= max_bytes) {
+        return {frame};
+    }
+    
+    // Bytes each sample brings to a piece: a value per column, plus its list
+    // entry when there is no clock
+    std::vector<size_t> sample_bytes(samples, 0);
+    for (const auto& column : frame.datacolumns()) {
+        for (size_t i = 0; i < samples; ++i) {
+            sample_bytes[i] += embeddedSize(column.datavalues(static_cast<int>(i)).ByteSizeLong());
+        }
+    }
+    if (!has_clock) {
+        for (size_t i = 0; i < samples; ++i) {
+            sample_bytes[i] += embeddedSize(timestamps.timestamplist().timestamps(static_cast<int>(i)).ByteSizeLong());
+        }
+    }
+    
+    // Bytes every piece pays whatever its samples: the timestamps wrapper and
+    // clock (whose start nanoseconds may grow by up to four bytes), and each
+    // column's name, with every length prefix at its five-byte maximum
+    size_t fixed = 2 * (1 + 5);
+    if (has_clock) {
+        fixed += embeddedSize(timestamps.samplingclock().ByteSizeLong()) + 4;
+    }
+    for (const auto& column : frame.datacolumns()) {
+        fixed += 1 + 5 + embeddedSize(column.name().size());
+    }
+    const size_t budget = max_bytes > fixed ? max_bytes - fixed : 0;
+    
+    std::vector<IngestionDataFrame> pieces;
+    size_t first = 0;
+    while (first < samples) {
+        size_t end = first + 1;
+        size_t bytes = sample_bytes[first];
+        while (end < samples && bytes + sample_bytes[end] <= budget) {
+            bytes += sample_bytes[end++];
+        }
+        pieces.push_back(sliceFrame(frame, first, end - first));
+        first = end;
+    }
+    return pieces;
+}
+
+std::vector<IngestDataRequest> IngestionClient::SplitIngestRequest(
+    const IngestDataRequest& request,
+    size_t max_bytes) {
+    
+    if (request.ByteSizeLong() <= max_bytes ||
+        request.GetReflection()->GetUnknownFields(request).field_count() > 0) {
+        return {request};
+    }
+    
+    IngestDataRequest envelope = request;
+    envelope.clear_ingestiondataframe();
+    
+    // Envelope, the split_part attribute and id suffix at their longest, and
+    // the frame's own tag and length
+    Attribute widest_part;
+    widest_part.set_name("split_part");
+    widest_part.set_value("4294967295/4294967295");
+    const size_t overhead = envelope.ByteSizeLong() + embeddedSize(widest_part.ByteSizeLong()) +
+                            std::string("_part4294967295").size() + 1 + 5;
+    
+    auto frames = SplitDataFrame(request.ingestiondataframe(),
+                                 max_bytes > overhead ? max_bytes - overhead : 0);
+    if (frames.size() <= 1) {
+        return {request};
+    }
+    
+    std::vector<IngestDataRequest> pieces;
+    pieces.reserve(frames.size());
+    for (size_t k = 0; k < frames.size(); ++k) {
+        IngestDataRequest piece = envelope;
+        piece.set_clientrequestid(request.clientrequestid() + "_part" + std::to_string(k + 1));
+        Attribute* part = piece.add_attributes();
+        part->set_name("split_part");
+        part->set_value(std::to_string(k + 1) + "/" + std::to_string(frames.size()));
+        *piece.mutable_ingestiondataframe() = std::move(frames[k]);
+        pieces.push_back(std::move(piece));
+    }
+    return pieces;
+}
+
+void IngestionClient::AttachSerializedColumns(
+    IngestDataRequest& request,
+    const std::vector<SerializedDataColumn>& columns) {
+    
+    using google::protobuf::io::CodedOutputStream;
+    constexpr int FRAME_FIELD = IngestDataRequest::kIngestionDataFrameFieldNumber;
+    constexpr uint8_t DATACOLUMNS_TAG =
+        (IngestionDataFrame::kDataColumnsFieldNumber << 3) | 2;  // Length-delimited
+    
+    size_t fragment_size = 0;
+    for (const auto& column : columns) {
+        size_t length = column.serializeddata().size();
+        fragment_size += 1 + CodedOutputStream::VarintSize64(length) + length;
+    }
+    
+    std::string* fragment = request.GetReflection()
+        ->MutableUnknownFields(&request)->AddLengthDelimited(FRAME_FIELD);
+    fragment->resize(fragment_size);
+    
+    uint8_t* out = reinterpret_cast<uint8_t*>(&(*fragment)[0]);
+    for (const auto& column : columns) {
+        const std::string& bytes = column.serializeddata();
+        *out++ = DATACOLUMNS_TAG;
+        out = CodedOutputStream::WriteVarint64ToArray(bytes.size(), out);
+        std::memcpy(out, bytes.data(), bytes.size());
+        out += bytes.size();
+    }
+}
+
 // ========== Streaming Ingestion ==========
 
 std::unique_ptr<IngestionClient::StreamIngestionSession> 
@@ -428,13 +1206,15 @@ IngestionClient::CreateStreamIngestionSession() {
                    std::chrono::seconds(pImpl->default_timeout_seconds * 10); // Longer timeout for streams
     context->set_deadline(deadline);
     
-    IngestDataStreamResponse response;
+    // The stub writes the final response through this pointer, so it must
+    // live as long as the session rather than this stack frame
+    auto response = std::make_shared<IngestDataStreamResponse>();
     auto writer = std::shared_ptr<grpc::ClientWriter<IngestDataRequest>>(
-        pImpl->stub->ingestDataStream(context.get(), &response));
+        pImpl->StreamStub().ingestDataStream(context.get(), response.get()));
     
-    pImpl->stats.stream_sessions++;
+    pImpl->CountStat(&ClientStats::stream_sessions);
     
-    return std::make_unique<StreamIngestionSession>(writer, context);
+    return std::make_unique<StreamIngestionSession>(writer, context, response);
 }
 
 std::unique_ptr<IngestionClient::BidiStreamIngestionSession> 
@@ -442,13 +1222,26 @@ IngestionClient::CreateBidiStreamIngestionSession() {
     auto context = std::make_shared<grpc::ClientContext>();
     
     auto stream = std::shared_ptr<grpc::ClientReaderWriter<IngestDataRequest, IngestDataResponse>>(
-        pImpl->stub->ingestDataBidiStream(context.get()));
+        pImpl->StreamStub().ingestDataBidiStream(context.get()));
     
-    pImpl->stats.stream_sessions++;
+    pImpl->CountStat(&ClientStats::stream_sessions);
     
     return std::make_unique<BidiStreamIngestionSession>(stream, context);
 }
 
+std::unique_ptr<IngestionClient::BulkIngestionSession>
+IngestionClient::CreateBulkIngestionSession(size_t max_in_flight) {
+    // No deadline: bulk sessions are meant to outlive many files
+    auto context = std::make_shared<grpc::ClientContext>();
+    
+    auto stream = std::shared_ptr<grpc::ClientReaderWriter<IngestDataRequest, IngestDataResponse>>(
+        pImpl->StreamStub().ingestDataBidiStream(context.get()));
+    
+    pImpl->CountStat(&ClientStats::stream_sessions);
+    
+    return std::make_unique<BulkIngestionSession>(stream, context, max_in_flight);
+}
+
 // ========== Request Status Query ==========
 
 std::vector<RequestStatus> IngestionClient::QueryRequestStatusByProviderId(
@@ -562,11 +1355,12 @@ QueryRequestStatusResponse IngestionClient::QueryRequestStatus(
                    std::chrono::seconds(pImpl->default_timeout_seconds);
     context.set_deadline(deadline);
     
-    grpc::Status status = pImpl->stub->queryRequestStatus(&context, request, &response);
+    ChannelPool::Lease lease(*pImpl->pool);
+    grpc::Status status = pImpl->stubs[lease.Index()]->queryRequestStatus(&context, request, &response);
+    lease.MarkOk(status.ok());
     
     if (!status.ok()) {
-        pImpl->last_error = status.error_message();
-        pImpl->stats.errors++;
+        pImpl->RecordError(status.error_message());
         
         if (!response.has_exceptionalresult()) {
             auto* exceptional = response.mutable_exceptionalresult();
@@ -629,9 +1423,9 @@ IngestionClient::CreateSubscriptionSession() {
     auto context = std::make_shared<grpc::ClientContext>();
     
     auto stream = std::shared_ptr<grpc::ClientReaderWriter<SubscribeDataRequest, SubscribeDataResponse>>(
-        pImpl->stub->subscribeData(context.get()));
+        pImpl->StreamStub().subscribeData(context.get()));
     
-    pImpl->stats.subscriptions++;
+    pImpl->CountStat(&ClientStats::subscriptions);
     
     return std::make_unique<SubscriptionSession>(stream, context);
 }
@@ -680,17 +1474,25 @@ std::future<void> IngestionClient::SubscribeToData(
 // ========== Utility Methods ==========
 
 bool IngestionClient::IsConnected() const {
-    return pImpl->channel->GetState(false) == GRPC_CHANNEL_READY;
+    return pImpl->pool->IsConnected();
 }
 
 grpc_connectivity_state IngestionClient::GetChannelState() const {
-    return pImpl->channel->GetState(false);
+    return pImpl->pool->GetState(false);
 }
 
 bool IngestionClient::WaitForConnection(int timeout_seconds) {
     auto deadline = std::chrono::system_clock::now() + 
                    std::chrono::seconds(timeout_seconds);
-    return pImpl->channel->WaitForConnected(deadline);
+    return pImpl->pool->WaitForConnected(deadline);
+}
+
+size_t IngestionClient::GetChannelCount() const {
+    return pImpl->pool->Size();
+}
+
+std::vector<ChannelPool::ChannelStats> IngestionClient::GetChannelStats() const {
+    return pImpl->pool->GetStats();
 }
 
 void IngestionClient::SetDefaultTimeout(int seconds) {
@@ -701,19 +1503,31 @@ int IngestionClient::GetDefaultTimeout() const {
     return pImpl->default_timeout_seconds;
 }
 
+void IngestionClient::SetMaxMessageBytes(size_t bytes) {
+    pImpl->max_message_bytes = bytes;
+}
+
+size_t IngestionClient::GetMaxMessageBytes() const {
+    return pImpl->max_message_bytes;
+}
+
 std::string IngestionClient::GetLastError() const {
+    std::lock_guard<std::mutex> lock(pImpl->state_mutex);
     return pImpl->last_error;
 }
 
 void IngestionClient::ClearLastError() {
+    std::lock_guard<std::mutex> lock(pImpl->state_mutex);
     pImpl->last_error.clear();
 }
 
 IngestionClient::ClientStats IngestionClient::GetStats() const {
+    std::lock_guard<std::mutex> lock(pImpl->state_mutex);
     return pImpl->stats;
 }
 
 void IngestionClient::ResetStats() {
+    std::lock_guard<std::mutex> lock(pImpl->state_mutex);
     pImpl->stats = ClientStats{};
 }
 
@@ -1,4 +1,5 @@
 #include "query_client.hpp"
+#include "column_encoder.hpp"
 #include <thread>
 #include <chrono>
 #include <atomic>
@@ -175,24 +176,42 @@ void QueryClient::BidiQuerySession::Cancel()
 class QueryClient::Impl
 {
 public:
-    std::shared_ptr<grpc::Channel> channel;
-    std::unique_ptr<DpQueryService::Stub> stub;
+    std::unique_ptr<ChannelPool> pool;
+    std::vector<std::unique_ptr<DpQueryService::Stub>> stubs; // One per pooled channel
     CommonClient common_client;
 
     int default_timeout_seconds = 30;
     std::string last_error;
     ClientStats stats;
 
-    Impl(std::shared_ptr<grpc::Channel> ch)
-        : channel(ch), stub(DpQueryService::NewStub(ch)) {}
+    explicit Impl(std::unique_ptr<ChannelPool> channel_pool)
+        : pool(std::move(channel_pool))
+    {
+        for (size_t i = 0; i < pool->Size(); ++i)
+        {
+            stubs.push_back(DpQueryService::NewStub(pool->GetChannel(i)));
+        }
+    }
+
+    // Streams are placed by the pool but not tracked as outstanding
+    DpQueryService::Stub &StreamStub()
+    {
+        size_t channel = pool->Acquire();
+        pool->Release(channel, true);
+        return *stubs[channel];
+    }
 };
 
 QueryClient::QueryClient(std::shared_ptr<grpc::Channel> channel)
-    : pImpl(std::make_unique<Impl>(channel)) {}
+    : pImpl(std::make_unique<Impl>(std::make_unique<ChannelPool>(channel))) {}
 
 QueryClient::QueryClient(const std::string &server_address)
+    : pImpl(std::make_unique<Impl>(std::make_unique<ChannelPool>(server_address, 1))) {}
+
+QueryClient::QueryClient(const std::string &server_address, size_t channel_count,
+                         ChannelPool::Policy policy, size_t max_message_bytes)
     : pImpl(std::make_unique<Impl>(
-          grpc::CreateChannel(server_address, grpc::InsecureChannelCredentials()))) {}
+          std::make_unique<ChannelPool>(server_address, channel_count, policy, max_message_bytes))) {}
 
 QueryClient::~QueryClient() = default;
 
@@ -250,7 +269,9 @@ QueryDataResponse QueryClient::QueryDataWithSpec(const QuerySpec &spec)
                     std::chrono::seconds(pImpl->default_timeout_seconds);
     context.set_deadline(deadline);
 
-    grpc::Status status = pImpl->stub->queryData(&context, request, &response);
+    ChannelPool::Lease lease(*pImpl->pool);
+    grpc::Status status = pImpl->stubs[lease.Index()]->queryData(&context, request, &response);
+    lease.MarkOk(status.ok());
 
     pImpl->stats.queries_executed++;
 
@@ -312,7 +333,7 @@ std::unique_ptr<QueryClient::StreamQuerySession> QueryClient::QueryDataStream(
     context->set_deadline(deadline);
 
     auto reader = std::shared_ptr<grpc::ClientReader<QueryDataResponse>>(
-        pImpl->stub->queryDataStream(context.get(), request));
+        pImpl->StreamStub().queryDataStream(context.get(), request));
 
     pImpl->stats.stream_queries++;
 
@@ -326,7 +347,7 @@ std::unique_ptr<QueryClient::BidiQuerySession> QueryClient::QueryDataBidiStream(
     auto context = std::make_shared<grpc::ClientContext>();
 
     auto stream = std::shared_ptr<grpc::ClientReaderWriter<QueryDataRequest, QueryDataResponse>>(
-        pImpl->stub->queryDataBidiStream(context.get()));
+        pImpl->StreamStub().queryDataBidiStream(context.get()));
 
     pImpl->stats.stream_queries++;
 
@@ -414,7 +435,9 @@ QueryTableResponse QueryClient::QueryTable(const QueryTableRequest &request)
                     std::chrono::seconds(pImpl->default_timeout_seconds);
     context.set_deadline(deadline);
 
-    grpc::Status status = pImpl->stub->queryTable(&context, request, &response);
+    ChannelPool::Lease lease(*pImpl->pool);
+    grpc::Status status = pImpl->stubs[lease.Index()]->queryTable(&context, request, &response);
+    lease.MarkOk(status.ok());
 
     pImpl->stats.table_queries++;
 
@@ -492,7 +515,9 @@ QueryPvMetadataResponse QueryClient::QueryPvMetadataWithResponse(
                     std::chrono::seconds(pImpl->default_timeout_seconds);
     context.set_deadline(deadline);
 
-    grpc::Status status = pImpl->stub->queryPvMetadata(&context, request, &response);
+    ChannelPool::Lease lease(*pImpl->pool);
+    grpc::Status status = pImpl->stubs[lease.Index()]->queryPvMetadata(&context, request, &response);
+    lease.MarkOk(status.ok());
 
     pImpl->stats.metadata_queries++;
 
@@ -629,7 +654,9 @@ QueryProvidersResponse QueryClient::QueryProviders(
                     std::chrono::seconds(pImpl->default_timeout_seconds);
     context.set_deadline(deadline);
 
-    grpc::Status status = pImpl->stub->queryProviders(&context, request, &response);
+    ChannelPool::Lease lease(*pImpl->pool);
+    grpc::Status status = pImpl->stubs[lease.Index()]->queryProviders(&context, request, &response);
+    lease.MarkOk(status.ok());
 
     pImpl->stats.provider_queries++;
 
@@ -713,7 +740,9 @@ QueryProviderMetadataResponse QueryClient::QueryProviderMetadataWithResponse(
                     std::chrono::seconds(pImpl->default_timeout_seconds);
     context.set_deadline(deadline);
 
-    grpc::Status status = pImpl->stub->queryProviderMetadata(&context, request, &response);
+    ChannelPool::Lease lease(*pImpl->pool);
+    grpc::Status status = pImpl->stubs[lease.Index()]->queryProviderMetadata(&context, request, &response);
+    lease.MarkOk(status.ok());
 
     pImpl->stats.metadata_queries++;
 
@@ -753,7 +782,7 @@ std::vector<DataValue> QueryClient::ExtractDataValues(const std::vector<DataBuck
             column = pImpl->common_client.DeserializeDataColumn(bucket.serializeddatacolumn());
         }
 
-        auto values = pImpl->common_client.ExtractDataValues(column);
+        auto values = pImpl->common_client.ExtractDataValues(ExpandSparseColumn(column));
         all_values.insert(all_values.end(), values.begin(), values.end());
     }
 
@@ -781,7 +810,7 @@ std::map<std::string, std::vector<DataValue>> QueryClient::ColumnTableToMap(
 
     for (const auto &column : table.datacolumns())
     {
-        result[column.name()] = pImpl->common_client.ExtractDataValues(column);
+        result[column.name()] = pImpl->common_client.ExtractDataValues(ExpandSparseColumn(column));
     }
 
     return result;
@@ -810,32 +839,53 @@ DataColumn QueryClient::DeserializeDataBucket(const DataBucket &bucket)
 {
     if (bucket.has_datacolumn())
     {
-        return bucket.datacolumn();
+        return ExpandSparseColumn(bucket.datacolumn());
     }
     else if (bucket.has_serializeddatacolumn())
     {
-        return pImpl->common_client.DeserializeDataColumn(bucket.serializeddatacolumn());
+        return ExpandSparseColumn(
+            pImpl->common_client.DeserializeDataColumn(bucket.serializeddatacolumn()));
     }
     return DataColumn();
 }
 
+DataColumn QueryClient::ExpandSparseColumn(const DataColumn &column)
+{
+    DataColumn dense;
+    if (ColumnEncoder::DecodeSparseColumn(column, dense))
+    {
+        return dense;
+    }
+    return column;
+}
+
 // ========== Connection and Error Management ==========
 
 bool QueryClient::IsConnected() const
 {
-    return pImpl->channel->GetState(false) == GRPC_CHANNEL_READY;
+    return pImpl->pool->IsConnected();
 }
 
 grpc_connectivity_state QueryClient::GetChannelState() const
 {
-    return pImpl->channel->GetState(false);
+    return pImpl->pool->GetState(false);
 }
 
 bool QueryClient::WaitForConnection(int timeout_seconds)
 {
     auto deadline = std::chrono::system_clock::now() +
                     std::chrono::seconds(timeout_seconds);
-    return pImpl->channel->WaitForConnected(deadline);
+    return pImpl->pool->WaitForConnected(deadline);
+}
+
+size_t QueryClient::GetChannelCount() const
+{
+    return pImpl->pool->Size();
+}
+
+std::vector<ChannelPool::ChannelStats> QueryClient::GetChannelStats() const
+{
+    return pImpl->pool->GetStats();
 }
 
 void QueryClient::SetDefaultTimeout(int seconds)
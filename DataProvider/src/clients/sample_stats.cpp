@@ -0,0 +1,434 @@
+#include "sample_stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// The AVX2 and AVX-512 kernels are compiled with per-function target
+// attributes and picked at run time, so the library needs no -m flags
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SAMPLE_STATS_DISPATCH 1
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+#if defined(__SSE2__) || defined(SAMPLE_STATS_DISPATCH)
+#include <immintrin.h>
+#endif
+
+double SampleStats::variance() const {
+    if (valid == 0) {
+        return 0.0;
+    }
+    double m = mean();
+    return std::max(0.0, sum_squares / valid - m * m);
+}
+
+double SampleStats::stdDev() const {
+    return std::sqrt(variance());
+}
+
+namespace {
+
+constexpr double POS_INF = std::numeric_limits<double>::infinity();
+
+// Accumulation starts from sentinels so vector lanes and the scalar tail
+// combine with plain min/max; finish() turns them back into the documented
+// values
+SampleStats start(size_t count) {
+    SampleStats stats;
+    stats.count = count;
+    stats.min = POS_INF;
+    stats.max = -POS_INF;
+    return stats;
+}
+
+void finish(SampleStats& stats) {
+    stats.inf = stats.count - stats.valid - stats.nan;
+    if (stats.valid == 0) {
+        stats.min = 0.0;
+        stats.max = 0.0;
+        stats.first_valid = SampleStats::NONE;
+        stats.last_valid = SampleStats::NONE;
+    }
+}
+
+// Samples [first, count) one at a time
+template<typename T>
+void accumulateScalar(const T* values, size_t first, size_t count, SampleStats& stats) {
+    for (size_t i = first; i < count; ++i) {
+        double v = static_cast<double>(values[i]);
+        bool finite = std::isfinite(v);
+        stats.valid += finite;
+        stats.nan += std::isnan(v);
+        if (finite) {
+            stats.sum += v;
+            stats.sum_squares += v * v;
+            stats.min = std::min(stats.min, v);
+            stats.max = std::max(stats.max, v);
+            if (stats.first_valid == SampleStats::NONE) {
+                stats.first_valid = i;
+            }
+            stats.last_valid = i;
+        }
+    }
+}
+
+// Lane indices are kept as doubles (exact below 2^53) so the first/last
+// valid index reduces with the same min/max as the values
+void mergeLanes(SampleStats& stats, uint64_t valid, uint64_t nan, double sum, double sum_squares,
+                double min, double max, double first, double last) {
+    stats.valid += valid;
+    stats.nan += nan;
+    stats.sum += sum;
+    stats.sum_squares += sum_squares;
+    stats.min = std::min(stats.min, min);
+    stats.max = std::max(stats.max, max);
+    if (valid > 0) {
+        stats.first_valid = static_cast<uint64_t>(first);
+        stats.last_valid = static_cast<uint64_t>(last);
+    }
+}
+
+// Lanes spilled to memory: `lanes` holds `width` values each of the sums,
+// sums of squares, minima, maxima, first and last indices in that order
+void mergeStoredLanes(SampleStats& stats, const uint64_t* valid, const uint64_t* nan,
+                      const double* lanes, size_t width) {
+    uint64_t valid_total = 0, nan_total = 0;
+    double sum_total = 0.0, squares_total = 0.0;
+    double min_all = POS_INF, max_all = -POS_INF, first_all = POS_INF, last_all = -1.0;
+    for (size_t lane = 0; lane < width; ++lane) {
+        valid_total += valid[lane];
+        nan_total += nan[lane];
+        sum_total += lanes[lane];
+        squares_total += lanes[width + lane];
+        min_all = std::min(min_all, lanes[2 * width + lane]);
+        max_all = std::max(max_all, lanes[3 * width + lane]);
+        first_all = std::min(first_all, lanes[4 * width + lane]);
+        last_all = std::max(last_all, lanes[5 * width + lane]);
+    }
+    mergeLanes(stats, valid_total, nan_total, sum_total, squares_total,
+               min_all, max_all, first_all, last_all);
+}
+
+#if defined(SAMPLE_STATS_DISPATCH)
+
+namespace avx512 {
+
+constexpr size_t LANES = 8;
+
+TARGET_AVX512 inline __m512d loadLanes(const double* p) { return _mm512_loadu_pd(p); }
+// Zero-masked so no undefined source vector is involved (-Wmaybe-uninitialized)
+TARGET_AVX512 inline __m512d loadLanes(const float* p) { return _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(p)); }
+
+// Comparisons yield lane masks, so every update is a masked instruction
+struct LaneAccumulator {
+    __m512i valid = _mm512_setzero_si512();
+    __m512i nan = _mm512_setzero_si512();
+    __m512d sum = _mm512_setzero_pd();
+    __m512d sum_squares = _mm512_setzero_pd();
+    __m512d min = _mm512_set1_pd(POS_INF);
+    __m512d max = _mm512_set1_pd(-POS_INF);
+    __m512d first = _mm512_set1_pd(POS_INF);
+    __m512d last = _mm512_set1_pd(-1.0);
+    __m512d index = _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7);
+
+    TARGET_AVX512 LaneAccumulator() {}
+
+    TARGET_AVX512 void add(__m512d v) {
+        const __m512i one = _mm512_set1_epi64(1);
+        __mmask8 finite = _mm512_cmp_pd_mask(_mm512_abs_pd(v), _mm512_set1_pd(POS_INF), _CMP_LT_OQ);
+        __mmask8 is_nan = _mm512_cmp_pd_mask(v, v, _CMP_UNORD_Q);
+        valid = _mm512_mask_add_epi64(valid, finite, valid, one);
+        nan = _mm512_mask_add_epi64(nan, is_nan, nan, one);
+        sum = _mm512_mask_add_pd(sum, finite, sum, v);
+        sum_squares = _mm512_mask3_fmadd_pd(v, v, sum_squares, finite);
+        min = _mm512_mask_min_pd(min, finite, min, v);
+        max = _mm512_mask_max_pd(max, finite, max, v);
+        first = _mm512_mask_min_pd(first, finite, first, index);
+        last = _mm512_mask_max_pd(last, finite, last, index);
+        index = _mm512_add_pd(index, _mm512_set1_pd(LANES));
+    }
+
+    TARGET_AVX512 void reduce(SampleStats& stats) const {
+        alignas(64) uint64_t valid_lanes[LANES], nan_lanes[LANES];
+        alignas(64) double lanes[6][LANES];
+        _mm512_store_si512(valid_lanes, valid);
+        _mm512_store_si512(nan_lanes, nan);
+        _mm512_store_pd(lanes[0], sum);
+        _mm512_store_pd(lanes[1], sum_squares);
+        _mm512_store_pd(lanes[2], min);
+        _mm512_store_pd(lanes[3], max);
+        _mm512_store_pd(lanes[4], first);
+        _mm512_store_pd(lanes[5], last);
+        mergeStoredLanes(stats, valid_lanes, nan_lanes, lanes[0], LANES);
+    }
+};
+
+// Whole vectors from the start of `values`; returns the first sample left
+// for the scalar tail
+template<typename T>
+TARGET_AVX512 size_t accumulate(const T* values, size_t count, SampleStats& stats) {
+    size_t i = 0;
+    if (count >= LANES) {
+        LaneAccumulator lanes;
+        for (; i + LANES <= count; i += LANES) {
+            lanes.add(loadLanes(values + i));
+        }
+        lanes.reduce(stats);
+    }
+    return i;
+}
+
+} // namespace avx512
+
+namespace avx2 {
+
+constexpr size_t LANES = 4;
+
+TARGET_AVX2 inline __m256d loadLanes(const double* p) { return _mm256_loadu_pd(p); }
+TARGET_AVX2 inline __m256d loadLanes(const float* p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+
+// Comparisons yield all-ones lanes: they are subtracted as -1 to count and
+// used as blend/and masks to drop non-finite samples from the sums
+struct LaneAccumulator {
+    __m256i valid = _mm256_setzero_si256();
+    __m256i nan = _mm256_setzero_si256();
+    __m256d sum = _mm256_setzero_pd();
+    __m256d sum_squares = _mm256_setzero_pd();
+    __m256d min = _mm256_set1_pd(POS_INF);
+    __m256d max = _mm256_set1_pd(-POS_INF);
+    __m256d first = _mm256_set1_pd(POS_INF);
+    __m256d last = _mm256_set1_pd(-1.0);
+    __m256d index = _mm256_setr_pd(0, 1, 2, 3);
+
+    TARGET_AVX2 LaneAccumulator() {}
+
+    TARGET_AVX2 void add(__m256d v) {
+        const __m256d pos_inf = _mm256_set1_pd(POS_INF);
+        const __m256d neg_inf = _mm256_set1_pd(-POS_INF);
+        const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+        __m256d finite = _mm256_cmp_pd(_mm256_and_pd(v, abs_mask), pos_inf, _CMP_LT_OQ);
+        __m256d is_nan = _mm256_cmp_pd(v, v, _CMP_UNORD_Q);
+        valid = _mm256_sub_epi64(valid, _mm256_castpd_si256(finite));
+        nan = _mm256_sub_epi64(nan, _mm256_castpd_si256(is_nan));
+        __m256d x = _mm256_and_pd(v, finite);
+        sum = _mm256_add_pd(sum, x);
+        sum_squares = _mm256_add_pd(sum_squares, _mm256_mul_pd(x, x));
+        min = _mm256_min_pd(min, _mm256_blendv_pd(pos_inf, v, finite));
+        max = _mm256_max_pd(max, _mm256_blendv_pd(neg_inf, v, finite));
+        first = _mm256_min_pd(first, _mm256_blendv_pd(pos_inf, index, finite));
+        last = _mm256_max_pd(last, _mm256_blendv_pd(_mm256_set1_pd(-1.0), index, finite));
+        index = _mm256_add_pd(index, _mm256_set1_pd(LANES));
+    }
+
+    TARGET_AVX2 void reduce(SampleStats& stats) const {
+        alignas(32) uint64_t valid_lanes[LANES], nan_lanes[LANES];
+        alignas(32) double lanes[6][LANES];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(valid_lanes), valid);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(nan_lanes), nan);
+        _mm256_store_pd(lanes[0], sum);
+        _mm256_store_pd(lanes[1], sum_squares);
+        _mm256_store_pd(lanes[2], min);
+        _mm256_store_pd(lanes[3], max);
+        _mm256_store_pd(lanes[4], first);
+        _mm256_store_pd(lanes[5], last);
+        mergeStoredLanes(stats, valid_lanes, nan_lanes, lanes[0], LANES);
+    }
+};
+
+template<typename T>
+TARGET_AVX2 size_t accumulate(const T* values, size_t count, SampleStats& stats) {
+    size_t i = 0;
+    if (count >= LANES) {
+        LaneAccumulator lanes;
+        for (; i + LANES <= count; i += LANES) {
+            lanes.add(loadLanes(values + i));
+        }
+        lanes.reduce(stats);
+    }
+    return i;
+}
+
+} // namespace avx2
+
+#endif
+
+#if defined(__SSE2__)
+
+namespace sse2 {
+
+constexpr size_t LANES = 2;
+
+inline __m128d loadLanes(const double* p) { return _mm_loadu_pd(p); }
+inline __m128d loadLanes(const float* p) {
+    return _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p))));
+}
+
+// mask ? a : b without SSE4.1 blendv
+inline __m128d select(__m128d mask, __m128d a, __m128d b) {
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+// Same scheme as the AVX2 accumulator, two lanes wide
+struct LaneAccumulator {
+    __m128i valid = _mm_setzero_si128();
+    __m128i nan = _mm_setzero_si128();
+    __m128d sum = _mm_setzero_pd();
+    __m128d sum_squares = _mm_setzero_pd();
+    __m128d min = _mm_set1_pd(POS_INF);
+    __m128d max = _mm_set1_pd(-POS_INF);
+    __m128d first = _mm_set1_pd(POS_INF);
+    __m128d last = _mm_set1_pd(-1.0);
+    __m128d index = _mm_setr_pd(0, 1);
+
+    void add(__m128d v) {
+        const __m128d pos_inf = _mm_set1_pd(POS_INF);
+        const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+        __m128d finite = _mm_cmplt_pd(_mm_and_pd(v, abs_mask), pos_inf);
+        __m128d is_nan = _mm_cmpunord_pd(v, v);
+        valid = _mm_sub_epi64(valid, _mm_castpd_si128(finite));
+        nan = _mm_sub_epi64(nan, _mm_castpd_si128(is_nan));
+        __m128d x = _mm_and_pd(v, finite);
+        sum = _mm_add_pd(sum, x);
+        sum_squares = _mm_add_pd(sum_squares, _mm_mul_pd(x, x));
+        min = _mm_min_pd(min, select(finite, v, pos_inf));
+        max = _mm_max_pd(max, select(finite, v, _mm_set1_pd(-POS_INF)));
+        first = _mm_min_pd(first, select(finite, index, pos_inf));
+        last = _mm_max_pd(last, select(finite, index, _mm_set1_pd(-1.0)));
+        index = _mm_add_pd(index, _mm_set1_pd(LANES));
+    }
+
+    void reduce(SampleStats& stats) const {
+        alignas(16) uint64_t valid_lanes[LANES], nan_lanes[LANES];
+        alignas(16) double lanes[6][LANES];
+        _mm_store_si128(reinterpret_cast<__m128i*>(valid_lanes), valid);
+        _mm_store_si128(reinterpret_cast<__m128i*>(nan_lanes), nan);
+        _mm_store_pd(lanes[0], sum);
+        _mm_store_pd(lanes[1], sum_squares);
+        _mm_store_pd(lanes[2], min);
+        _mm_store_pd(lanes[3], max);
+        _mm_store_pd(lanes[4], first);
+        _mm_store_pd(lanes[5], last);
+        mergeLanes(stats, valid_lanes[0] + valid_lanes[1], nan_lanes[0] + nan_lanes[1],
+                   lanes[0][0] + lanes[0][1], lanes[1][0] + lanes[1][1],
+                   std::min(lanes[2][0], lanes[2][1]), std::max(lanes[3][0], lanes[3][1]),
+                   std::min(lanes[4][0], lanes[4][1]), std::max(lanes[5][0], lanes[5][1]));
+    }
+};
+
+template<typename T>
+size_t accumulate(const T* values, size_t count, SampleStats& stats) {
+    size_t i = 0;
+    if (count >= LANES) {
+        LaneAccumulator lanes;
+        for (; i + LANES <= count; i += LANES) {
+            lanes.add(loadLanes(values + i));
+        }
+        lanes.reduce(stats);
+    }
+    return i;
+}
+
+} // namespace sse2
+
+#endif
+
+enum class Kernel { SCALAR, SSE2, AVX2, AVX512 };
+
+// Widest kernel both the build and the CPU support, decided once
+Kernel detectKernel() {
+#if defined(SAMPLE_STATS_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return Kernel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return Kernel::AVX2;
+    }
+#endif
+#if defined(__SSE2__)
+    return Kernel::SSE2;
+#else
+    return Kernel::SCALAR;
+#endif
+}
+
+const Kernel KERNEL = detectKernel();
+
+} // namespace
+
+template<typename T>
+SampleStats SampleStatsKernel::computeFloating(const T* values, size_t count) {
+    SampleStats stats = start(count);
+    size_t i = 0;
+    switch (KERNEL) {
+#if defined(SAMPLE_STATS_DISPATCH)
+        case Kernel::AVX512:
+            i = avx512::accumulate(values, count, stats);
+            break;
+        case Kernel::AVX2:
+            i = avx2::accumulate(values, count, stats);
+            break;
+#endif
+#if defined(__SSE2__)
+        case Kernel::SSE2:
+            i = sse2::accumulate(values, count, stats);
+            break;
+#endif
+        default:
+            break;
+    }
+    accumulateScalar(values, i, count, stats);
+    finish(stats);
+    return stats;
+}
+
+// Extremes in the native type (vectorized by the compiler), sums in double
+template<typename T>
+SampleStats SampleStatsKernel::computeIntegers(const T* values, size_t count) {
+    SampleStats stats = start(count);
+    stats.valid = count;
+    if (count == 0) {
+        finish(stats);
+        return stats;
+    }
+    T min = values[0];
+    T max = values[0];
+    for (size_t i = 0; i < count; ++i) {
+        double v = static_cast<double>(values[i]);
+        stats.sum += v;
+        stats.sum_squares += v * v;
+        min = std::min(min, values[i]);
+        max = std::max(max, values[i]);
+    }
+    stats.min = static_cast<double>(min);
+    stats.max = static_cast<double>(max);
+    stats.first_valid = 0;
+    stats.last_valid = count - 1;
+    finish(stats);
+    return stats;
+}
+
+SampleStats SampleStatsKernel::Compute(const double* values, size_t count) {
+    return computeFloating(values, count);
+}
+
+SampleStats SampleStatsKernel::Compute(const float* values, size_t count) {
+    return computeFloating(values, count);
+}
+
+SampleStats SampleStatsKernel::Compute(const int32_t* values, size_t count) {
+    return computeIntegers(values, count);
+}
+
+SampleStats SampleStatsKernel::Compute(const int64_t* values, size_t count) {
+    return computeIntegers(values, count);
+}
+
+SampleStats SampleStatsKernel::Compute(const uint32_t* values, size_t count) {
+    return computeIntegers(values, count);
+}
+
+SampleStats SampleStatsKernel::Compute(const uint64_t* values, size_t count) {
+    return computeIntegers(values, count);
+}
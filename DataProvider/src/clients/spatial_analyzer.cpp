@@ -1,4 +1,5 @@
 #include "spatial_analyzer.hpp"
+#include "name_tokenizer.hpp"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -127,23 +128,8 @@ void SpatialAnalyzer::buildPatternCache() {
 bool SpatialAnalyzer::parsePVNameOptimized(std::string_view pvName, 
                                          std::string& deviceType, std::string& area, 
                                          std::string& position, std::string& attribute) {
-    constexpr char delimiter = ':';
-    std::vector<std::string_view> parts;
-    parts.reserve(4);
-    
-    size_t start = 0;
-    size_t pos = 0;
-    
-    while ((pos = pvName.find(delimiter, start)) != std::string_view::npos) {
-        parts.emplace_back(pvName.substr(start, pos - start));
-        start = pos + 1;
-    }
-    
-    if (start < pvName.length()) {
-        parts.emplace_back(pvName.substr(start));
-    }
-    
-    if (parts.size() >= 4) {
+    std::string_view parts[4];
+    if (NameTokenizer::Split(pvName, ':', parts, 4) == 4) {
         deviceType = std::string(parts[0]);
         area = std::string(parts[1]);
         position = std::string(parts[2]);
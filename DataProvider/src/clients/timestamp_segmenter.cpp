@@ -0,0 +1,138 @@
+#include "timestamp_segmenter.hpp"
+#include <algorithm>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+void TimestampSegmenter::ToEpochNanos(const uint64_t* seconds, const uint64_t* nanoseconds,
+                                      size_t count, uint64_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = seconds[i] * 1000000000ULL + (nanoseconds ? nanoseconds[i] : 0);
+    }
+}
+
+std::vector<uint64_t> TimestampSegmenter::ToEpochNanos(const std::vector<uint64_t>& seconds,
+                                                       const std::vector<uint64_t>& nanoseconds) {
+    std::vector<uint64_t> epoch_nanos(seconds.size());
+    bool has_nanos = nanoseconds.size() == seconds.size();
+    ToEpochNanos(seconds.data(), has_nanos ? nanoseconds.data() : nullptr,
+                 seconds.size(), epoch_nanos.data());
+    return epoch_nanos;
+}
+
+// Intervals are checked a block at a time: (t[i+1] - t[i]) ^ period is
+// OR-ed over the block and the block passes if the result is zero. The
+// first block that fails is finished element by element.
+size_t TimestampSegmenter::ExtendRun(const uint64_t* t, size_t count,
+                                     size_t index, uint64_t period) {
+#if defined(__AVX2__)
+    const __m256i expected = _mm256_set1_epi64x(static_cast<long long>(period));
+    while (index + 4 < count) {
+        __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t + index));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t + index + 1));
+        __m256i mismatch = _mm256_xor_si256(_mm256_sub_epi64(next, current), expected);
+        if (!_mm256_testz_si256(mismatch, mismatch)) {
+            break;
+        }
+        index += 4;
+    }
+#elif defined(__SSE2__)
+    const __m128i expected = _mm_set1_epi64x(static_cast<long long>(period));
+    const __m128i zero = _mm_setzero_si128();
+    while (index + 4 < count) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + index));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + index + 1));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + index + 2));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t + index + 3));
+        __m128i mismatch = _mm_or_si128(_mm_xor_si128(_mm_sub_epi64(b, a), expected),
+                                        _mm_xor_si128(_mm_sub_epi64(d, c), expected));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(mismatch, zero)) != 0xFFFF) {
+            break;
+        }
+        index += 4;
+    }
+#endif
+    while (index + 1 < count && t[index + 1] - t[index] == period) {
+        ++index;
+    }
+    return index;
+}
+
+std::vector<TimestampRun> TimestampSegmenter::Segment(const uint64_t* t, size_t count,
+                                                      size_t min_run) {
+    std::vector<TimestampRun> runs;
+    if (count == 0) {
+        return runs;
+    }
+    if (min_run < 2) {
+        min_run = 2;
+    }
+
+    size_t irregular_start = count;  // count = no irregular samples pending
+    auto flushIrregular = [&](size_t end) {
+        if (irregular_start < end) {
+            runs.push_back({irregular_start, end - irregular_start, 0, 0});
+        }
+        irregular_start = count;
+    };
+
+    size_t i = 0;
+    while (i < count) {
+        // [i, end) is the longest equal-interval stretch starting at i
+        size_t end = i + 1;
+        uint64_t period = 0;
+        if (i + 1 < count && t[i + 1] > t[i]) {
+            period = t[i + 1] - t[i];
+            end = ExtendRun(t, count, i + 1, period) + 1;
+        }
+
+        bool whole_array = i == 0 && end == count && count >= 2;
+        if (period > 0 && (end - i >= min_run || whole_array)) {
+            flushIrregular(i);
+            runs.push_back({i, end - i, period, 1});
+            i = end;
+            continue;
+        }
+
+        // Too short. A run starting inside [i, end - 1) would share its
+        // period and end, so the next candidate start is end - 1.
+        if (irregular_start == count) {
+            irregular_start = i;
+        }
+        i = end - 1 > i ? end - 1 : i + 1;
+    }
+    flushIrregular(count);
+    return runs;
+}
+
+uint64_t TimestampSegmenter::DominantPeriod(const std::vector<TimestampRun>& runs) {
+    uint64_t period = 0;
+    uint64_t longest = 0;
+    for (const auto& run : runs) {
+        if (run.isRegular() && run.count > longest) {
+            longest = run.count;
+            period = run.period_nanos;
+        }
+    }
+    return period;
+}
+
+std::vector<TimestampRun> TimestampSegmenter::Split(const std::vector<TimestampRun>& runs,
+                                                    size_t sample_bytes, size_t max_bytes) {
+    std::vector<TimestampRun> pieces;
+    pieces.reserve(runs.size());
+    for (const auto& run : runs) {
+        size_t cost = std::max<size_t>(1, sample_bytes + (run.isRegular() ? 0 : MAX_LIST_ENTRY_BYTES));
+        uint64_t per_piece = std::max<size_t>(1, max_bytes / cost);
+        // Even pieces rather than full ones and a short tail
+        uint64_t piece_count = (run.count + per_piece - 1) / per_piece;
+        per_piece = piece_count > 1 ? (run.count + piece_count - 1) / piece_count : run.count;
+        for (uint64_t offset = 0; offset < run.count; offset += per_piece) {
+            TimestampRun piece = run;
+            piece.first = run.first + offset;
+            piece.count = std::min(per_piece, run.count - offset);
+            pieces.push_back(piece);
+        }
+    }
+    return pieces;
+}
@@ -0,0 +1,87 @@
+#include "column_codec.hpp"
+#include "delta_of_delta_codec.hpp"
+#include "xor_codec.hpp"
+
+namespace {
+
+constexpr char MAGIC[] = {'D', 'P', 'C'};
+constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 1;
+
+}  // namespace
+
+void ColumnCodec::appendHeader(Codec codec, size_t count, std::string& out) {
+    out.append(MAGIC, sizeof(MAGIC));
+    out.push_back(static_cast<char>(codec));
+    uint64_t remaining = count;
+    while (remaining >= 0x80) {
+        out.push_back(static_cast<char>((remaining & 0x7F) | 0x80));
+        remaining >>= 7;
+    }
+    out.push_back(static_cast<char>(remaining));
+}
+
+bool ColumnCodec::readHeader(const std::string& payload, Codec expected, size_t& count, size_t& offset) {
+    if (Identify(payload) != expected) {
+        return false;
+    }
+    uint64_t value = 0;
+    offset = HEADER_SIZE;
+    for (unsigned shift = 0;; shift += 7) {
+        if (offset >= payload.size() || shift > 63) {
+            return false;
+        }
+        uint8_t byte = static_cast<uint8_t>(payload[offset++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    // Every sample after the first costs at least one bit, so a count
+    // beyond that is corrupt; this also bounds the allocation
+    if (value > 1 + (payload.size() - offset) * 8) {
+        return false;
+    }
+    count = static_cast<size_t>(value);
+    return true;
+}
+
+void ColumnCodec::AppendDoubles(const double* values, size_t count, std::string& out) {
+    appendHeader(Codec::XOR_DOUBLE, count, out);
+    XorCodec::Encode(values, count, out);
+}
+
+void ColumnCodec::AppendIntegers(const uint64_t* values, size_t count, std::string& out) {
+    appendHeader(Codec::DELTA_OF_DELTA, count, out);
+    DeltaOfDeltaCodec::Encode(values, count, out);
+}
+
+ColumnCodec::Codec ColumnCodec::Identify(const std::string& payload) {
+    if (payload.size() < HEADER_SIZE || payload.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0) {
+        return Codec::NONE;
+    }
+    auto codec = static_cast<Codec>(payload[sizeof(MAGIC)]);
+    if (codec != Codec::XOR_DOUBLE && codec != Codec::DELTA_OF_DELTA) {
+        return Codec::NONE;
+    }
+    return codec;
+}
+
+bool ColumnCodec::DecodeDoubles(const std::string& payload, std::vector<double>& values) {
+    size_t count, offset;
+    if (!readHeader(payload, Codec::XOR_DOUBLE, count, offset)) {
+        return false;
+    }
+    values.resize(count);
+    return XorCodec::Decode(reinterpret_cast<const uint8_t*>(payload.data()) + offset,
+                            payload.size() - offset, count, values.data());
+}
+
+bool ColumnCodec::DecodeIntegers(const std::string& payload, std::vector<uint64_t>& values) {
+    size_t count, offset;
+    if (!readHeader(payload, Codec::DELTA_OF_DELTA, count, offset)) {
+        return false;
+    }
+    values.resize(count);
+    return DeltaOfDeltaCodec::Decode(reinterpret_cast<const uint8_t*>(payload.data()) + offset,
+                                     payload.size() - offset, count, values.data());
+}
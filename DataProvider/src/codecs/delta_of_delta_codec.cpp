@@ -0,0 +1,109 @@
+#include "delta_of_delta_codec.hpp"
+#include "bit_stream.hpp"
+#include "word_scan.hpp"
+#include <vector>
+
+namespace {
+
+inline uint64_t zigzag(uint64_t value) {
+    return (value << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+}
+
+inline uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+}  // namespace
+
+void DeltaOfDeltaCodec::Encode(const uint64_t* values, size_t count, std::string& out) {
+    if (count == 0) {
+        return;
+    }
+
+    thread_local std::vector<uint64_t> words;
+    words.resize(count);
+    WordScan::DeltaOfDeltas(values, count, words.data());
+
+    out.reserve(out.size() + 8 + count / 4);
+    BitWriter writer(out);
+    writer.write(values[0], 64);
+
+    for (size_t i = 1; i < count;) {
+        if (words[i] == 0) {
+            size_t run = WordScan::ZeroRun(words.data(), i, count);
+            writer.writeZeros(run);
+            i += run;
+            continue;
+        }
+
+        uint64_t z = zigzag(words[i]);
+        if (z <= 0xFF) {
+            writer.write(0b10, 2);
+            writer.write(z, 8);
+        } else if (z <= 0xFFFF) {
+            writer.write(0b110, 3);
+            writer.write(z, 16);
+        } else if (z <= 0xFFFFFFFF) {
+            writer.write(0b1110, 4);
+            writer.write(z, 32);
+        } else {
+            writer.write(0b1111, 4);
+            writer.write(z, 64);
+        }
+        ++i;
+    }
+
+    writer.finish();
+}
+
+bool DeltaOfDeltaCodec::Decode(const uint8_t* data, size_t size, size_t count, uint64_t* out) {
+    if (count == 0) {
+        return true;
+    }
+
+    BitReader reader(data, size);
+    uint64_t value;
+    if (!reader.read(64, value)) {
+        return false;
+    }
+    out[0] = value;
+
+    uint64_t delta = 0;
+    for (size_t i = 1; i < count;) {
+        size_t steady = reader.skipZeros(count - i);
+        for (size_t end = i + steady; i < end; ++i) {
+            value += delta;
+            out[i] = value;
+        }
+        if (i == count) {
+            break;
+        }
+
+        // skipZeros stopped on the leading '1'; each further '1', up to
+        // three, selects the next wider bucket
+        uint64_t bit;
+        if (!reader.read(1, bit)) {
+            return false;
+        }
+        unsigned ones = 0;
+        while (ones < 3) {
+            if (!reader.read(1, bit)) {
+                return false;
+            }
+            if (bit == 0) {
+                break;
+            }
+            ++ones;
+        }
+        static constexpr unsigned WIDTHS[] = {8, 16, 32, 64};
+        uint64_t z;
+        if (!reader.read(WIDTHS[ones], z)) {
+            return false;
+        }
+        delta += unzigzag(z);
+        value += delta;
+        out[i] = value;
+        ++i;
+    }
+    return true;
+}
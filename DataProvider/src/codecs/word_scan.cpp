@@ -0,0 +1,174 @@
+#include "word_scan.hpp"
+#include <cstring>
+
+// The AVX2 loops are compiled with a target attribute and picked at run
+// time, so the library needs no -m flags
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define WORD_SCAN_DISPATCH 1
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#if defined(__SSE2__) || defined(WORD_SCAN_DISPATCH)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Each vector loop starts at `i`, covers whole vectors up to `count` and
+// returns where the scalar tail picks up
+
+#if defined(WORD_SCAN_DISPATCH)
+
+namespace avx2 {
+
+TARGET_AVX2 size_t xorAdjacent(const double* values, size_t i, size_t count, uint64_t* out) {
+    for (; i + 4 <= count; i += 4) {
+        __m256i current = _mm256_castpd_si256(_mm256_loadu_pd(values + i));
+        __m256i previous = _mm256_castpd_si256(_mm256_loadu_pd(values + i - 1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(current, previous));
+    }
+    return i;
+}
+
+TARGET_AVX2 size_t deltaOfDeltas(const uint64_t* timestamps, size_t i, size_t count, uint64_t* out) {
+    for (; i + 4 <= count; i += 4) {
+        __m256i t0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(timestamps + i));
+        __m256i t1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(timestamps + i - 1));
+        __m256i t2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(timestamps + i - 2));
+        __m256i dod = _mm256_add_epi64(_mm256_sub_epi64(t0, _mm256_add_epi64(t1, t1)), t2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), dod);
+    }
+    return i;
+}
+
+// Stops early, at the first non-zero word, when the run ends inside a vector
+TARGET_AVX2 size_t zeroRun(const uint64_t* words, size_t i, size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        int zeros = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, zero)));
+        if (zeros != 0xF) {
+            return i + static_cast<size_t>(__builtin_ctz(~zeros));
+        }
+    }
+    return i;
+}
+
+} // namespace avx2
+
+#endif
+
+#if defined(__SSE2__)
+
+namespace sse2 {
+
+size_t xorAdjacent(const double* values, size_t i, size_t count, uint64_t* out) {
+    for (; i + 2 <= count; i += 2) {
+        __m128i current = _mm_castpd_si128(_mm_loadu_pd(values + i));
+        __m128i previous = _mm_castpd_si128(_mm_loadu_pd(values + i - 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(current, previous));
+    }
+    return i;
+}
+
+size_t deltaOfDeltas(const uint64_t* timestamps, size_t i, size_t count, uint64_t* out) {
+    for (; i + 2 <= count; i += 2) {
+        __m128i t0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(timestamps + i));
+        __m128i t1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(timestamps + i - 1));
+        __m128i t2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(timestamps + i - 2));
+        __m128i dod = _mm_add_epi64(_mm_sub_epi64(t0, _mm_add_epi64(t1, t1)), t2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), dod);
+    }
+    return i;
+}
+
+// No 64-bit compare before SSE4.1; a word is zero when all eight bytes are
+size_t zeroRun(const uint64_t* words, size_t i, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+        int zeros = _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+        if (zeros != 0xFFFF) {
+            return i + ((zeros & 0xFF) == 0xFF ? 1 : 0);
+        }
+    }
+    return i;
+}
+
+} // namespace sse2
+
+#endif
+
+bool detectAvx2() {
+#if defined(WORD_SCAN_DISPATCH)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Decided once; SSE2 (or scalar) when the CPU lacks AVX2
+const bool USE_AVX2 = detectAvx2();
+
+} // namespace
+
+void WordScan::XorAdjacent(const double* values, size_t count, uint64_t* out) {
+    if (count == 0) {
+        return;
+    }
+    std::memcpy(out, values, sizeof(uint64_t));
+    size_t i = 1;
+#if defined(WORD_SCAN_DISPATCH)
+    if (USE_AVX2) {
+        i = avx2::xorAdjacent(values, i, count, out);
+    }
+#endif
+#if defined(__SSE2__)
+    i = sse2::xorAdjacent(values, i, count, out);
+#endif
+    for (; i < count; ++i) {
+        uint64_t current, previous;
+        std::memcpy(&current, values + i, sizeof(current));
+        std::memcpy(&previous, values + i - 1, sizeof(previous));
+        out[i] = current ^ previous;
+    }
+}
+
+void WordScan::DeltaOfDeltas(const uint64_t* timestamps, size_t count, uint64_t* out) {
+    if (count == 0) {
+        return;
+    }
+    out[0] = 0;
+    if (count == 1) {
+        return;
+    }
+    out[1] = timestamps[1] - timestamps[0];
+    size_t i = 2;
+#if defined(WORD_SCAN_DISPATCH)
+    if (USE_AVX2) {
+        i = avx2::deltaOfDeltas(timestamps, i, count, out);
+    }
+#endif
+#if defined(__SSE2__)
+    i = sse2::deltaOfDeltas(timestamps, i, count, out);
+#endif
+    for (; i < count; ++i) {
+        out[i] = timestamps[i] - 2 * timestamps[i - 1] + timestamps[i - 2];
+    }
+}
+
+size_t WordScan::ZeroRun(const uint64_t* words, size_t begin, size_t count) {
+    size_t i = begin;
+#if defined(WORD_SCAN_DISPATCH)
+    if (USE_AVX2) {
+        i = avx2::zeroRun(words, i, count);
+    }
+#endif
+#if defined(__SSE2__)
+    i = sse2::zeroRun(words, i, count);
+#endif
+    for (; i < count && words[i] == 0; ++i) {
+    }
+    return i - begin;
+}
@@ -0,0 +1,118 @@
+#include "xor_codec.hpp"
+#include "bit_stream.hpp"
+#include "word_scan.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr unsigned MAX_LEADING = 31;  // Largest count the 5-bit field holds
+
+}  // namespace
+
+void XorCodec::Encode(const double* values, size_t count, std::string& out) {
+    if (count == 0) {
+        return;
+    }
+
+    thread_local std::vector<uint64_t> words;
+    words.resize(count);
+    WordScan::XorAdjacent(values, count, words.data());
+
+    out.reserve(out.size() + 8 + count);
+    BitWriter writer(out);
+    writer.write(words[0], 64);
+
+    bool has_window = false;
+    unsigned window_leading = 0;
+    unsigned window_trailing = 0;
+
+    for (size_t i = 1; i < count;) {
+        const uint64_t x = words[i];
+        if (x == 0) {
+            size_t run = WordScan::ZeroRun(words.data(), i, count);
+            writer.writeZeros(run);
+            i += run;
+            continue;
+        }
+
+        unsigned leading = std::min<unsigned>(__builtin_clzll(x), MAX_LEADING);
+        unsigned trailing = __builtin_ctzll(x);
+
+        if (has_window && leading >= window_leading && trailing >= window_trailing) {
+            writer.write(0b10, 2);
+            writer.write(x >> window_trailing, 64 - window_leading - window_trailing);
+        } else {
+            unsigned length = 64 - leading - trailing;
+            writer.write(0b11, 2);
+            writer.write(leading, 5);
+            writer.write(length & 63, 6);
+            writer.write(x >> trailing, length);
+            has_window = true;
+            window_leading = leading;
+            window_trailing = trailing;
+        }
+        ++i;
+    }
+
+    writer.finish();
+}
+
+bool XorCodec::Decode(const uint8_t* data, size_t size, size_t count, double* out) {
+    if (count == 0) {
+        return true;
+    }
+
+    BitReader reader(data, size);
+    uint64_t bits;
+    if (!reader.read(64, bits)) {
+        return false;
+    }
+    std::memcpy(out, &bits, sizeof(bits));
+
+    bool has_window = false;
+    unsigned window_leading = 0;
+    unsigned window_trailing = 0;
+
+    for (size_t i = 1; i < count;) {
+        size_t repeats = reader.skipZeros(count - i);
+        for (size_t end = i + repeats; i < end; ++i) {
+            out[i] = out[i - 1];
+        }
+        if (i == count) {
+            break;
+        }
+
+        uint64_t control;
+        if (!reader.read(2, control)) {
+            return false;
+        }
+        if (control == 0b11) {
+            uint64_t leading, length;
+            if (!reader.read(5, leading) || !reader.read(6, length)) {
+                return false;
+            }
+            if (length == 0) {
+                length = 64;
+            }
+            if (leading + length > 64) {
+                return false;
+            }
+            has_window = true;
+            window_leading = static_cast<unsigned>(leading);
+            window_trailing = static_cast<unsigned>(64 - leading - length);
+        } else if (!has_window) {
+            return false;
+        }
+
+        uint64_t meaningful;
+        if (!reader.read(64 - window_leading - window_trailing, meaningful)) {
+            return false;
+        }
+        bits ^= meaningful << window_trailing;
+        std::memcpy(out + i, &bits, sizeof(bits));
+        ++i;
+    }
+    return true;
+}
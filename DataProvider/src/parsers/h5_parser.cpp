@@ -1,12 +1,151 @@
 #include "h5_parser.hpp"
+#include "name_tokenizer.hpp"
 #include <filesystem>
-#include <regex>
 #include <iostream>
 #include <algorithm>
 #include <ctime>
 #include <stdexcept>
 #include <set>
 #include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <zlib.h>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Pick the dataset dimension that runs along time: an exact match with the
+// timestamp count, then a near match, then the longest dimension
+int findTimeDimension(const hsize_t* dims, int ndims, size_t timestamp_count) {
+    for (int i = 0; i < ndims; i++) {
+        if (dims[i] == timestamp_count) {
+            return i;
+        }
+    }
+
+    for (int i = 0; i < ndims; i++) {
+        double ratio = (double)dims[i] / timestamp_count;
+        if (ratio > 0.99 && ratio < 1.01) {
+            return i;
+        }
+    }
+
+    if (ndims == 1) {
+        return 0;
+    }
+    if (ndims == 2 && (dims[0] == 1 || dims[1] == 1)) {
+        return (dims[0] > dims[1]) ? 0 : 1;
+    }
+
+    int time_dim_index = 0;
+    for (int i = 1; i < ndims; i++) {
+        if (dims[i] > dims[time_dim_index]) {
+            time_dim_index = i;
+        }
+    }
+    return time_dim_index;
+}
+
+// Switch `column` to alternative `index` (an empty vector)
+template<size_t I = 0>
+void emplaceColumn(SignalColumn& column, size_t index) {
+    if constexpr (I < std::variant_size_v<SignalColumn>) {
+        if (index == I) {
+            column.emplace<I>();
+        } else {
+            emplaceColumn<I + 1>(column, index);
+        }
+    } else {
+        throw std::runtime_error("Invalid signal column type " + std::to_string(index));
+    }
+}
+
+} // namespace
+
+// ========== Signal Selection ==========
+
+bool SignalSelector::empty() const {
+    return include.empty() && exclude.empty() && devices.empty() &&
+           areas.empty() && attributes.empty();
+}
+
+bool SignalSelector::matches(std::string_view signal_name) const {
+    auto anyGlob = [&](const std::vector<std::string>& globs) {
+        for (const auto& glob : globs) {
+            if (NameTokenizer::GlobMatch(glob, signal_name)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (!include.empty() && !anyGlob(include)) {
+        return false;
+    }
+    if (anyGlob(exclude)) {
+        return false;
+    }
+
+    if (devices.empty() && areas.empty() && attributes.empty()) {
+        return true;
+    }
+    NameTokenizer::SignalNameTokens tokens;
+    if (!NameTokenizer::ParseSignalName(signal_name, tokens)) {
+        return false;
+    }
+    auto accepts = [](const std::vector<std::string>& values, std::string_view field) {
+        return values.empty() || std::find(values.begin(), values.end(), field) != values.end();
+    };
+    return accepts(devices, tokens.device) && accepts(areas, tokens.area) &&
+           accepts(attributes, tokens.attribute);
+}
+
+// ========== Signal Data ==========
+
+size_t SignalData::sampleCount() const {
+    if (!values.empty()) {
+        return values.size();
+    }
+    return std::visit([](const auto& native) { return native.size(); }, column);
+}
+
+std::vector<double> SignalData::toDoubleValues() const {
+    if (!values.empty()) {
+        return values;
+    }
+    return std::visit([](const auto& native) {
+        using T = typename std::decay_t<decltype(native)>::value_type;
+        std::vector<double> widened(native.size());
+        if constexpr (std::is_same_v<T, float> || std::is_same_v<T, int32_t>) {
+            H5NumericReader::widen(native.data(), widened.data(), native.size());
+        } else {
+            std::transform(native.begin(), native.end(), widened.begin(),
+                           [](T value) { return static_cast<double>(value); });
+        }
+        return widened;
+    }, column);
+}
+
+void H5Parser::setTimeWindow(uint64_t begin_nanos, uint64_t end_nanos) {
+    time_window_set_ = true;
+    window_begin_nanos_ = begin_nanos;
+    window_end_nanos_ = end_nanos;
+}
+
+void H5Parser::clearTimeWindow() {
+    time_window_set_ = false;
+    window_begin_nanos_ = 0;
+    window_end_nanos_ = 0;
+}
 
 H5Parser::H5Parser(const std::string& h5_directory_path)
     : h5_directory_(h5_directory_path), spatial_enrichment_enabled_(false) {
@@ -21,16 +160,75 @@ void H5Parser::enableSpatialEnrichment(bool enable) {
     spatial_enrichment_enabled_ = enable;
 }
 
+// Visitor that fills parsed_signals_ and file_timestamps_, i.e. the
+// classic accumulate-everything behaviour
+class H5Parser::CollectingVisitor : public SignalVisitor {
+public:
+    explicit CollectingVisitor(H5Parser& parser) : parser_(parser) {}
+
+    void onFileStart(const H5FileMetadata& file,
+                     const std::shared_ptr<TimestampData>& timestamps) override {
+        parser_.file_timestamps_[file.full_path] = timestamps;
+    }
+
+    void onSignal(SignalData&& signal) override {
+        parser_.parsed_signals_.push_back(std::move(signal));
+        parser_.indexSignal(parser_.parsed_signals_.size() - 1);
+    }
+
+private:
+    H5Parser& parser_;
+};
+
+std::vector<std::string> H5Parser::discoverParsableFiles() const {
+    auto h5_files = discoverH5Files();
+    h5_files.erase(std::remove_if(h5_files.begin(), h5_files.end(),
+                                  [this](const std::string& filepath) {
+                                      return !matchesNamingConvention(filepath);
+                                  }),
+                   h5_files.end());
+    return h5_files;
+}
+
 bool H5Parser::parseDirectory() {
     try {
-        auto h5_files = discoverH5Files();
+        auto h5_files = discoverParsableFiles();
         if (h5_files.empty()) {
             return false;
         }
 
+        if (parallel_readers_ > 1 && h5_files.size() > 1) {
+            CollectingVisitor collector(*this);
+            return parseFilesInReaderProcesses(h5_files, collector) > 0;
+        }
+
+        size_t valid_files = 0;
+        for (const auto& filepath : h5_files) {
+            if (parseFile(filepath)) {
+                valid_files++;
+            }
+        }
+
+        return valid_files > 0;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool H5Parser::parseDirectory(SignalVisitor& visitor) {
+    try {
+        auto h5_files = discoverParsableFiles();
+        if (h5_files.empty()) {
+            return false;
+        }
+
+        if (parallel_readers_ > 1 && h5_files.size() > 1) {
+            return parseFilesInReaderProcesses(h5_files, visitor) > 0;
+        }
+
         size_t valid_files = 0;
         for (const auto& filepath : h5_files) {
-            if (matchesNamingConvention(filepath) && parseFile(filepath)) {
+            if (parseFile(filepath, visitor)) {
                 valid_files++;
             }
         }
@@ -42,40 +240,47 @@ bool H5Parser::parseDirectory() {
 }
 
 bool H5Parser::parseFile(const std::string& filepath) {
+    CollectingVisitor collector(*this);
+    return parseFile(filepath, collector);
+}
+
+bool H5Parser::parseFile(const std::string& filepath, SignalVisitor& visitor) {
     try {
         H5FileMetadata file_metadata = parseFilename(filepath);
         H5::Exception::dontPrint();
         H5::H5File file(filepath, H5F_ACC_RDONLY);
+        std::shared_ptr<const MappedH5File> mapping =
+            memory_mapping_ ? MappedH5File::open(filepath) : nullptr;
 
+        // Timestamps kept from an earlier parse may cover a different time
+        // window, so they are only reused when no window is set
         std::shared_ptr<TimestampData> timestamps;
         auto timestamp_it = file_timestamps_.find(filepath);
-        if (timestamp_it != file_timestamps_.end()) {
+        if (timestamp_it != file_timestamps_.end() && !time_window_set_ &&
+            timestamp_it->second && timestamp_it->second->first_index == 0 &&
+            timestamp_it->second->count == timestamp_it->second->file_count) {
             timestamps = timestamp_it->second;
         } else {
             timestamps = extractTimestamps(file);
-            file_timestamps_[filepath] = timestamps;
         }
 
-        if (!timestamps || timestamps->count == 0) {
-            return false;
-        }
-
-        auto signal_names = getSignalDatasets(file);
-        if (signal_names.empty()) {
-            return false;
-        }
+        visitor.onFileStart(file_metadata, timestamps);
 
         size_t successful_signals = 0;
+        auto signal_names = (timestamps && timestamps->count > 0)
+            ? getSignalDatasets(file) : std::vector<std::string>();
+
         for (const auto& signal_name : signal_names) {
             try {
-                SignalData signal_data = processSignal(file, signal_name, timestamps, file_metadata);
+                SignalData signal_data = processSignal(file, signal_name, timestamps, file_metadata,
+                                                       mapping.get());
 
-                if (validateDataConsistency(signal_data.values, *timestamps, signal_name)) {
+                if (validateDataConsistency(signal_data, *timestamps)) {
                     if (spatial_enrichment_enabled_) {
                         signal_data.spatial_enrichment_ready = true;
                     }
                     
-                    parsed_signals_.push_back(std::move(signal_data));
+                    visitor.onSignal(std::move(signal_data));
                     successful_signals++;
                 }
             } catch (const std::exception&) {
@@ -84,6 +289,7 @@ bool H5Parser::parseFile(const std::string& filepath) {
         }
 
         file.close();
+        visitor.onFileEnd(file_metadata, successful_signals);
         return successful_signals > 0;
 
     } catch (const H5::Exception&) {
@@ -93,6 +299,29 @@ bool H5Parser::parseFile(const std::string& filepath) {
     }
 }
 
+std::vector<std::string> H5Parser::listSignals(const std::string& filepath) const {
+    try {
+        H5::Exception::dontPrint();
+        H5::H5File file(filepath, H5F_ACC_RDONLY);
+        auto signal_names = getSignalDatasets(file);
+        file.close();
+        return signal_names;
+    } catch (const H5::Exception&) {
+        return {};
+    }
+}
+
+std::unique_ptr<SignalChunkReader> H5Parser::openSignalReader(
+    const std::string& filepath,
+    const std::string& signal_name,
+    size_t chunk_samples) const {
+    auto reader = std::make_unique<SignalChunkReader>(filepath, signal_name, chunk_samples);
+    if (!reader->isOpen()) {
+        return nullptr;
+    }
+    return reader;
+}
+
 std::vector<std::string> H5Parser::discoverH5Files() const {
     std::vector<std::string> h5_files;
 
@@ -111,31 +340,23 @@ std::vector<std::string> H5Parser::discoverH5Files() const {
 }
 
 bool H5Parser::matchesNamingConvention(const std::string& filepath) const {
-    std::filesystem::path path(filepath);
-    std::string filename = path.stem().string();
-
-    std::regex pattern(R"(([A-Z]+)_([A-Z]+)_(\d{8})_(\d{6})(?:_([A-Za-z0-9]+))?)");
-    return std::regex_match(filename, pattern);
+    NameTokenizer::FilenameTokens tokens;
+    return NameTokenizer::ParseFilename(NameTokenizer::Stem(filepath), tokens);
 }
 
 H5FileMetadata H5Parser::parseFilename(const std::string& filepath) const {
     H5FileMetadata metadata;
     metadata.full_path = filepath;
 
-    std::filesystem::path path(filepath);
-    std::string filename = path.stem().string();
-
-    std::regex pattern(R"(([A-Z]+)_([A-Z]+)_(\d{8})_(\d{6})(?:_([A-Za-z0-9]+))?)");
-    std::smatch matches;
-
-    if (std::regex_match(filename, matches, pattern)) {
-        metadata.origin = matches[1].str();
-        metadata.pathway = matches[2].str();
-        metadata.date = matches[3].str();
-        metadata.time = matches[4].str();
+    NameTokenizer::FilenameTokens tokens;
+    if (NameTokenizer::ParseFilename(NameTokenizer::Stem(filepath), tokens)) {
+        metadata.origin = tokens.origin;
+        metadata.pathway = tokens.pathway;
+        metadata.date = tokens.date;
+        metadata.time = tokens.time;
 
-        if (matches.size() > 5 && matches[5].matched) {
-            metadata.project = matches[5].str();
+        if (!tokens.project.empty()) {
+            metadata.project = tokens.project;
         } else {
             metadata.project = "default";
         }
@@ -198,29 +419,55 @@ std::shared_ptr<TimestampData> H5Parser::extractTimestamps(H5::H5File& file) con
         hsize_t dims[1];
         seconds_space.getSimpleExtentDims(dims);
 
-        timestamps->seconds.resize(dims[0]);
-        seconds_ds.read(timestamps->seconds.data(), H5::PredType::NATIVE_UINT64);
-
-        if (file.nameExists("nanoseconds")) {
-            H5::DataSet nanos_ds = file.openDataSet("nanoseconds");
-            H5::DataSpace nanos_space = nanos_ds.getSpace();
+        H5::DataSet nanos_ds;
+        bool has_nanos = file.nameExists("nanoseconds");
+        if (has_nanos) {
+            nanos_ds = file.openDataSet("nanoseconds");
             hsize_t nano_dims[1];
-            nanos_space.getSimpleExtentDims(nano_dims);
+            nanos_ds.getSpace().getSimpleExtentDims(nano_dims);
 
             if (nano_dims[0] != dims[0]) {
                 throw std::runtime_error("Timestamp array size mismatch");
             }
+        }
 
-            timestamps->nanoseconds.resize(dims[0]);
-            nanos_ds.read(timestamps->nanoseconds.data(), H5::PredType::NATIVE_UINT64);
-
+        // Sample range to read: everything, or the part of the sorted
+        // timestamps inside the time window
+        size_t first = 0;
+        size_t last = dims[0];
+        if (time_window_set_) {
+            const H5::DataSet* nanos = has_nanos ? &nanos_ds : nullptr;
+            first = lowerBoundSample(seconds_ds, nanos, dims[0], window_begin_nanos_);
+            last = window_end_nanos_ == UINT64_MAX ? dims[0]
+                 : lowerBoundSample(seconds_ds, nanos, dims[0], window_end_nanos_ + 1);
+            last = std::max(first, last);
+        }
+        const size_t count = last - first;
+
+        timestamps->seconds.resize(count);
+        timestamps->nanoseconds.resize(count, 0);
+        if (count > 0) {
+            hsize_t offset[1] = {first};
+            hsize_t window[1] = {count};
+            H5::DataSpace memspace(1, window);
+            seconds_space.selectHyperslab(H5S_SELECT_SET, window, offset);
+            seconds_ds.read(timestamps->seconds.data(), H5::PredType::NATIVE_UINT64,
+                            memspace, seconds_space);
+
+            if (has_nanos) {
+                H5::DataSpace nanos_space = nanos_ds.getSpace();
+                nanos_space.selectHyperslab(H5S_SELECT_SET, window, offset);
+                nanos_ds.read(timestamps->nanoseconds.data(), H5::PredType::NATIVE_UINT64,
+                              memspace, nanos_space);
+            }
+        }
+        if (has_nanos) {
             nanos_ds.close();
-            nanos_space.close();
-        } else {
-            timestamps->nanoseconds.resize(dims[0], 0);
         }
 
-        timestamps->count = dims[0];
+        timestamps->count = count;
+        timestamps->first_index = first;
+        timestamps->file_count = dims[0];
         if (timestamps->count > 0) {
             timestamps->start_time_sec = timestamps->seconds[0];
             timestamps->start_time_nano = timestamps->nanoseconds[0];
@@ -228,7 +475,13 @@ std::shared_ptr<TimestampData> H5Parser::extractTimestamps(H5::H5File& file) con
             timestamps->end_time_nano = timestamps->nanoseconds[timestamps->count - 1];
         }
 
-        timestamps->period_nanos = calculatePeriodNanos(timestamps->seconds, timestamps->nanoseconds);
+        // One pass over the whole array splits it into exact buckets
+        std::vector<uint64_t> epoch_nanos =
+            TimestampSegmenter::ToEpochNanos(timestamps->seconds, timestamps->nanoseconds);
+        timestamps->runs = TimestampSegmenter::Segment(epoch_nanos.data(), epoch_nanos.size());
+        uint64_t dominant = TimestampSegmenter::DominantPeriod(timestamps->runs);
+        timestamps->period_nanos = dominant ? dominant
+            : calculatePeriodNanos(timestamps->seconds, timestamps->nanoseconds);
         timestamps->is_regular_sampling = checkRegularSampling(timestamps->seconds,
                                                               timestamps->nanoseconds,
                                                               timestamps->period_nanos);
@@ -245,6 +498,40 @@ std::shared_ptr<TimestampData> H5Parser::extractTimestamps(H5::H5File& file) con
     return timestamps;
 }
 
+size_t H5Parser::lowerBoundSample(const H5::DataSet& seconds_ds, const H5::DataSet* nanos_ds,
+                                  size_t count, uint64_t target_nanos) const {
+    // Each probe reads one element, so the search costs O(log n) tiny reads
+    // instead of loading the whole timestamp array
+    hsize_t one[1] = {1};
+    H5::DataSpace memspace(1, one);
+    auto sampleTime = [&](size_t index) {
+        hsize_t offset[1] = {index};
+        uint64_t seconds = 0;
+        uint64_t nanos = 0;
+        H5::DataSpace space = seconds_ds.getSpace();
+        space.selectHyperslab(H5S_SELECT_SET, one, offset);
+        seconds_ds.read(&seconds, H5::PredType::NATIVE_UINT64, memspace, space);
+        if (nanos_ds) {
+            H5::DataSpace nanos_space = nanos_ds->getSpace();
+            nanos_space.selectHyperslab(H5S_SELECT_SET, one, offset);
+            nanos_ds->read(&nanos, H5::PredType::NATIVE_UINT64, memspace, nanos_space);
+        }
+        return seconds * 1000000000ULL + nanos;
+    };
+
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (sampleTime(mid) < target_nanos) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
 std::vector<std::string> H5Parser::getSignalDatasets(H5::H5File& file) const {
     std::vector<std::string> signal_names;
 
@@ -252,13 +539,18 @@ std::vector<std::string> H5Parser::getSignalDatasets(H5::H5File& file) const {
         H5::Group root = file.openGroup("/");
         hsize_t num_objects = root.getNumObjs();
 
+        const bool select_all = selector_.empty();
         for (hsize_t i = 0; i < num_objects; i++) {
             std::string obj_name = root.getObjnameByIdx(i);
-            H5G_obj_t obj_type = root.getObjTypeByIdx(i);
 
             if (obj_name == "secondsPastEpoch" || obj_name == "nanoseconds") {
                 continue;
             }
+            if (!select_all && !selector_.matches(obj_name)) {
+                continue;
+            }
+
+            H5G_obj_t obj_type = root.getObjTypeByIdx(i);
 
             if (obj_type == H5G_DATASET) {
                 signal_names.push_back(obj_name);
@@ -278,14 +570,12 @@ SignalInfo H5Parser::parseSignalName(const std::string& signal_name) const {
     SignalInfo info;
     info.full_name = signal_name;
 
-    std::regex pattern(R"(([A-Z]+)_([A-Z0-9]+)_(\d+)_([A-Z0-9_]+))");
-    std::smatch matches;
-
-    if (std::regex_match(signal_name, matches, pattern)) {
-        info.device = matches[1].str();
-        info.device_area = matches[2].str();
-        info.device_location = matches[3].str();
-        info.device_attribute = matches[4].str();
+    NameTokenizer::SignalNameTokens tokens;
+    if (NameTokenizer::ParseSignalName(signal_name, tokens)) {
+        info.device = tokens.device;
+        info.device_area = tokens.area;
+        info.device_location = tokens.location;
+        info.device_attribute = tokens.attribute;
 
         info.units = inferUnits(info.device_attribute);
         info.signal_type = inferSignalType(info.device_attribute);
@@ -304,7 +594,8 @@ SignalInfo H5Parser::parseSignalName(const std::string& signal_name) const {
 SignalData H5Parser::processSignal(H5::H5File& file,
                                    const std::string& signal_name,
                                    std::shared_ptr<TimestampData> timestamps,
-                                   const H5FileMetadata& file_metadata) const {
+                                   const H5FileMetadata& file_metadata,
+                                   const MappedH5File* mapping) const {
     SignalData signal_data;
 
     signal_data.info = parseSignalName(signal_name);
@@ -324,114 +615,63 @@ SignalData H5Parser::processSignal(H5::H5File& file,
             throw std::runtime_error("Signal dataset must be 1D-3D, got " + std::to_string(ndims) + "D");
         }
 
-        // Find time dimension that matches timestamp count
-        int time_dim_index = -1;
-        size_t time_dimension = 0;
-
-        for (int i = 0; i < ndims; i++) {
-            if (dims[i] == timestamps->count) {
-                time_dim_index = i;
-                time_dimension = dims[i];
-                break;
+        // Match dimensions against the file's full timestamp count; with a
+        // time window only [first_index, first_index + count) is read
+        size_t file_count = timestamps->file_count ? timestamps->file_count : timestamps->count;
+        int time_dim_index = findTimeDimension(dims, ndims, file_count);
+        bool windowed = timestamps->count != file_count || timestamps->first_index != 0;
+
+        size_t first_sample = 0;
+        size_t time_dimension = dims[time_dim_index];
+        if (windowed) {
+            if (dims[time_dim_index] < timestamps->first_index + timestamps->count) {
+                throw std::runtime_error("Signal shorter than the time window: " + signal_name);
             }
+            first_sample = timestamps->first_index;
+            time_dimension = timestamps->count;
         }
 
-        if (time_dim_index == -1) {
-            for (int i = 0; i < ndims; i++) {
-                double ratio = (double)dims[i] / timestamps->count;
-                if (ratio > 0.99 && ratio < 1.01) {
-                    time_dim_index = i;
-                    time_dimension = dims[i];
-                    break;
-                }
-            }
-        }
-
-        if (time_dim_index == -1) {
-            if (ndims == 1) {
-                time_dim_index = 0;
-                time_dimension = dims[0];
-            } else if (ndims == 2 && (dims[0] == 1 || dims[1] == 1)) {
-                time_dim_index = (dims[0] > dims[1]) ? 0 : 1;
-                time_dimension = dims[time_dim_index];
-            } else {
-                time_dim_index = 0;
-                for (int i = 1; i < ndims; i++) {
-                    if (dims[i] > dims[time_dim_index]) {
-                        time_dim_index = i;
-                    }
-                }
-                time_dimension = dims[time_dim_index];
-            }
+        if (!preserve_native_types_) {
+            signal_data.values.resize(time_dimension);
         }
 
-        signal_data.values.resize(time_dimension);
-
-        // Extract data based on dimensionality
-        if (ndims == 1) {
-            try {
-                dataset.read(signal_data.values.data(), H5::PredType::NATIVE_DOUBLE);
-            } catch (const H5::Exception&) {
-                std::vector<float> float_values(dims[0]);
-                dataset.read(float_values.data(), H5::PredType::NATIVE_FLOAT);
-                for (size_t i = 0; i < float_values.size(); ++i) {
-                    signal_data.values[i] = static_cast<double>(float_values[i]);
-                }
-            }
-        } else if (ndims == 2) {
-            if (time_dim_index == 0) {
-                hsize_t offset[2] = {0, 0};
-                hsize_t count[2] = {dims[0], 1};
-                hsize_t mem_dims[1] = {dims[0]};
-
-                H5::DataSpace memspace(1, mem_dims);
-                dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
-
-                try {
-                    dataset.read(signal_data.values.data(), H5::PredType::NATIVE_DOUBLE, memspace, dataspace);
-                } catch (const H5::Exception&) {
-                    std::vector<float> float_values(dims[0]);
-                    dataset.read(float_values.data(), H5::PredType::NATIVE_FLOAT, memspace, dataspace);
-                    for (size_t i = 0; i < float_values.size(); ++i) {
-                        signal_data.values[i] = static_cast<double>(float_values[i]);
-                    }
-                }
-            } else {
-                hsize_t offset[2] = {0, 0};
-                hsize_t count[2] = {1, dims[1]};
-                hsize_t mem_dims[1] = {dims[1]};
-
-                H5::DataSpace memspace(1, mem_dims);
-                dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
-
-                try {
-                    dataset.read(signal_data.values.data(), H5::PredType::NATIVE_DOUBLE, memspace, dataspace);
-                } catch (const H5::Exception&) {
-                    std::vector<float> float_values(dims[1]);
-                    dataset.read(float_values.data(), H5::PredType::NATIVE_FLOAT, memspace, dataspace);
-                    for (size_t i = 0; i < float_values.size(); ++i) {
-                        signal_data.values[i] = static_cast<double>(float_values[i]);
-                    }
-                }
+        // One type lookup per dataset, then a single read of the right type
+        H5NumericReader::Storage storage = H5NumericReader::classify(dataset);
+        auto readValues = [&](const H5::DataSpace& memspace, const H5::DataSpace& filespace) {
+            bool numeric = preserve_native_types_
+                ? H5NumericReader::readNative(dataset, storage, signal_data.column,
+                                              time_dimension, memspace, filespace)
+                : H5NumericReader::read(dataset, storage, signal_data.values.data(),
+                                        signal_data.values.size(), memspace, filespace);
+            if (!numeric) {
+                throw std::runtime_error("Signal dataset is not numeric: " + signal_name);
             }
-        } else if (ndims == 3) {
-            hsize_t offset[3] = {0, 0, 0};
-            hsize_t count[3] = {1, 1, 1};
-            count[time_dim_index] = dims[time_dim_index];
-
-            hsize_t mem_dims[1] = {dims[time_dim_index]};
+        };
+
+        // Contiguous 1D datasets are copied straight out of the file mapping;
+        // a window is just an offset into the array
+        ContiguousExtent extent;
+        bool mapped = mapping && ndims == 1 && H5ContiguousReader::locate(dataset, extent) &&
+            (preserve_native_types_
+                ? H5ContiguousReader::copyNative(extent, *mapping, first_sample, time_dimension,
+                                                 signal_data.column)
+                : H5ContiguousReader::copy(extent, *mapping, first_sample, time_dimension,
+                                           signal_data.values.data()));
+
+        if (!mapped && ndims == 1 && !windowed) {
+            readValues(H5::DataSpace::ALL, H5::DataSpace::ALL);
+        } else if (!mapped) {
+            // The time samples at index 0 of every other dimension
+            hsize_t offset[MAX_DIMS] = {0, 0, 0};
+            hsize_t count[MAX_DIMS] = {1, 1, 1};
+            offset[time_dim_index] = first_sample;
+            count[time_dim_index] = time_dimension;
+
+            hsize_t mem_dims[1] = {time_dimension};
             H5::DataSpace memspace(1, mem_dims);
             dataspace.selectHyperslab(H5S_SELECT_SET, count, offset);
 
-            try {
-                dataset.read(signal_data.values.data(), H5::PredType::NATIVE_DOUBLE, memspace, dataspace);
-            } catch (const H5::Exception&) {
-                std::vector<float> float_values(dims[time_dim_index]);
-                dataset.read(float_values.data(), H5::PredType::NATIVE_FLOAT, memspace, dataspace);
-                for (size_t i = 0; i < float_values.size(); ++i) {
-                    signal_data.values[i] = static_cast<double>(float_values[i]);
-                }
-            }
+            readValues(memspace, dataspace);
         }
 
         signal_data.info.label = readStringAttribute(dataset, "label");
@@ -492,13 +732,13 @@ bool H5Parser::checkRegularSampling(const std::vector<uint64_t>& seconds,
         return true;
     }
 
+    // Every interval of the array, not just the first few
     const uint64_t tolerance = 1000;
-    size_t check_count = std::min(size_t(10), seconds.size() - 1);
-
-    for (size_t i = 1; i <= check_count; ++i) {
+    uint64_t prev_ns = seconds[0] * 1000000000ULL + nanoseconds[0];
+    for (size_t i = 1; i < seconds.size(); ++i) {
         uint64_t current_ns = seconds[i] * 1000000000ULL + nanoseconds[i];
-        uint64_t prev_ns = seconds[i-1] * 1000000000ULL + nanoseconds[i-1];
         uint64_t actual_period = current_ns - prev_ns;
+        prev_ns = current_ns;
 
         if (std::abs(static_cast<int64_t>(actual_period - expected_period)) > static_cast<int64_t>(tolerance)) {
             return false;
@@ -537,28 +777,1060 @@ std::string H5Parser::inferSignalType(const std::string& device_attribute) const
     return "measurement";
 }
 
-bool H5Parser::validateDataConsistency(const std::vector<double>& values,
-                                       const TimestampData& timestamps,
-                                       const std::string& signal_name) const {
-    if (values.size() != timestamps.count) {
+bool H5Parser::validateDataConsistency(SignalData& signal,
+                                       const TimestampData& timestamps) const {
+    size_t count = signal.sampleCount();
+    if (count == 0 || count != timestamps.count) {
         return false;
     }
 
-    if (values.empty()) {
+    // One pass over the samples; kept with the signal so consumers don't rescan
+    if (!signal.values.empty()) {
+        signal.quality = SampleStatsKernel::Compute(signal.values.data(), signal.values.size());
+    } else {
+        signal.quality = std::visit([](const auto& native) {
+            return SampleStatsKernel::Compute(native.data(), native.size());
+        }, signal.column);
+    }
+
+    // Allow signals with all NaN/inf values
+    return true;
+}
+
+// ========== Numeric Dataset Reading ==========
+
+H5NumericReader::Storage H5NumericReader::classify(const H5::DataSet& dataset) {
+    switch (dataset.getTypeClass()) {
+        case H5T_FLOAT:
+            return dataset.getFloatType().getSize() == sizeof(float) ? Storage::Float32
+                                                                     : Storage::Float64;
+        case H5T_INTEGER: {
+            H5::IntType type = dataset.getIntType();
+            bool narrow = type.getSize() <= sizeof(int32_t);
+            if (type.getSign() == H5T_SGN_NONE) {
+                return narrow ? Storage::UInt32 : Storage::UInt64;
+            }
+            return narrow ? Storage::Int32 : Storage::Int64;
+        }
+        default:
+            return Storage::Unsupported;
+    }
+}
+
+const H5::PredType& H5NumericReader::memoryType(Storage storage) {
+    switch (storage) {
+        case Storage::Float32: return H5::PredType::NATIVE_FLOAT;
+        case Storage::Int32:   return H5::PredType::NATIVE_INT32;
+        case Storage::Int64:   return H5::PredType::NATIVE_INT64;
+        case Storage::UInt32:  return H5::PredType::NATIVE_UINT32;
+        case Storage::UInt64:  return H5::PredType::NATIVE_UINT64;
+        default:               return H5::PredType::NATIVE_DOUBLE;
+    }
+}
+
+bool H5NumericReader::readNative(const H5::DataSet& dataset, Storage storage,
+                                 SignalColumn& column, size_t count,
+                                 const H5::DataSpace& memspace,
+                                 const H5::DataSpace& filespace) {
+    if (storage == Storage::Unsupported) {
         return false;
     }
+    size_t index = static_cast<size_t>(storage);
+    if (column.index() != index) {
+        emplaceColumn(column, index);
+    }
+    std::visit([&](auto& native) {
+        native.resize(count);
+        dataset.read(native.data(), memoryType(storage), memspace, filespace);
+    }, column);
+    return true;
+}
 
-    size_t invalid_count = 0;
-    for (double value : values) {
-        if (std::isnan(value) || std::isinf(value)) {
-            invalid_count++;
+bool H5NumericReader::read(const H5::DataSet& dataset, Storage storage,
+                           double* out, size_t count,
+                           const H5::DataSpace& memspace,
+                           const H5::DataSpace& filespace) {
+    // Narrow reads land in a per-thread scratch buffer that is reused
+    thread_local std::vector<float> float_scratch;
+    thread_local std::vector<int32_t> int_scratch;
+
+    switch (storage) {
+        case Storage::Float64:
+        case Storage::Int64:
+        case Storage::UInt32:
+        case Storage::UInt64:
+            dataset.read(out, H5::PredType::NATIVE_DOUBLE, memspace, filespace);
+            return true;
+        case Storage::Float32:
+            float_scratch.resize(count);
+            dataset.read(float_scratch.data(), H5::PredType::NATIVE_FLOAT, memspace, filespace);
+            widen(float_scratch.data(), out, count);
+            return true;
+        case Storage::Int32:
+            int_scratch.resize(count);
+            dataset.read(int_scratch.data(), H5::PredType::NATIVE_INT32, memspace, filespace);
+            widen(int_scratch.data(), out, count);
+            return true;
+        case Storage::Unsupported:
+            break;
+    }
+    return false;
+}
+
+// Both conversions are exact and keep NaN/inf, so the vector paths and the
+// scalar tail agree bit for bit
+void H5NumericReader::widen(const float* src, double* dst, size_t count) {
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 8 <= count; i += 8) {
+        __m256 v = _mm256_loadu_ps(src + i);
+        _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        _mm256_storeu_pd(dst + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+#elif defined(__SSE2__)
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(src + i);
+        _mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+        _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = static_cast<double>(src[i]);
+    }
+}
+
+void H5NumericReader::widen(const int32_t* src, double* dst, size_t count) {
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(v));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_pd(dst + i, _mm_cvtepi32_pd(v));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] = static_cast<double>(src[i]);
+    }
+}
+
+// ========== Direct Chunk Reading ==========
+
+size_t RawChunkedDataset::chunkLength(size_t index) const {
+    size_t offset = chunkOffset(index);
+    return offset >= sample_count ? 0 : std::min(chunk_samples, sample_count - offset);
+}
+
+size_t RawChunkedDataset::storedBytes() const {
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.bytes.size();
+    }
+    return total;
+}
+
+bool H5ChunkReader::fetch(const H5::DataSet& dataset, RawChunkedDataset& raw) {
+    raw = RawChunkedDataset();
+
+    H5::DSetCreatPropList plist = dataset.getCreatePlist();
+    if (plist.getLayout() != H5D_CHUNKED) {
+        return false;
+    }
+
+    H5::DataSpace space = dataset.getSpace();
+    if (space.getSimpleExtentNdims() != 1) {
+        return false;
+    }
+    hsize_t dims[1];
+    space.getSimpleExtentDims(dims);
+    hsize_t chunk_dims[1];
+    plist.getChunk(1, chunk_dims);
+    if (dims[0] == 0 || chunk_dims[0] == 0) {
+        return false;
+    }
+
+    // Chunks are handed out byte for byte, so the stored type must already be
+    // the memory type (same size and byte order)
+    H5NumericReader::Storage storage = H5NumericReader::classify(dataset);
+    if (storage == H5NumericReader::Storage::Unsupported) {
+        return false;
+    }
+    H5::DataType file_type = dataset.getDataType();
+    if (!(file_type == H5NumericReader::memoryType(storage))) {
+        return false;
+    }
+
+    std::vector<int> filters;
+    int filter_count = plist.getNfilters();
+    for (int i = 0; i < filter_count; ++i) {
+        unsigned flags = 0;
+        size_t cd_count = 0;
+        H5Z_filter_t filter = H5Pget_filter2(plist.getId(), static_cast<unsigned>(i), &flags,
+                                             &cd_count, nullptr, 0, nullptr, nullptr);
+        if (filter != H5Z_FILTER_DEFLATE && filter != H5Z_FILTER_SHUFFLE) {
+            return false;
         }
+        filters.push_back(filter);
+    }
+    // Without filters a plain read is already a copy; nothing to move out of the lock
+    if (filters.empty()) {
+        return false;
     }
 
-    // Allow signals with all NaN/inf values
+    size_t chunk_count = (dims[0] + chunk_dims[0] - 1) / chunk_dims[0];
+    std::vector<RawChunkedDataset::Chunk> chunks(chunk_count);
+    for (size_t i = 0; i < chunk_count; ++i) {
+        hsize_t offset[1] = {i * chunk_dims[0]};
+        hsize_t stored = 0;
+        // Unallocated chunks read back as the fill value; leave those to HDF5
+        if (H5Dget_chunk_storage_size(dataset.getId(), offset, &stored) < 0 || stored == 0) {
+            return false;
+        }
+        chunks[i].bytes.resize(stored);
+        if (H5Dread_chunk(dataset.getId(), H5P_DEFAULT, offset, &chunks[i].filter_mask,
+                          chunks[i].bytes.data()) < 0) {
+            throw H5::DataSetIException("H5ChunkReader::fetch", "H5Dread_chunk failed");
+        }
+    }
+
+    raw.storage = storage;
+    raw.element_size = file_type.getSize();
+    raw.sample_count = dims[0];
+    raw.chunk_samples = chunk_dims[0];
+    raw.filters = std::move(filters);
+    raw.chunks = std::move(chunks);
+    return true;
+}
+
+bool H5ChunkReader::decodeChunk(const RawChunkedDataset& raw, size_t index, void* out) {
+    if (index >= raw.chunks.size()) {
+        return false;
+    }
+    const RawChunkedDataset::Chunk& chunk = raw.chunks[index];
+    const size_t chunk_bytes = raw.chunk_samples * raw.element_size;
+
+    // Each stage reads `data` and writes the other scratch buffer
+    thread_local std::vector<uint8_t> scratch[2];
+    const uint8_t* data = chunk.bytes.data();
+    size_t size = chunk.bytes.size();
+    size_t next = 0;
+
+    // Undo the pipeline last filter first, skipping the ones the mask marks
+    for (size_t f = raw.filters.size(); f-- > 0;) {
+        if (chunk.filter_mask & (1u << f)) {
+            continue;
+        }
+        std::vector<uint8_t>& target = scratch[next];
+        target.resize(chunk_bytes);
+
+        if (raw.filters[f] == H5Z_FILTER_DEFLATE) {
+            uLongf inflated = static_cast<uLongf>(chunk_bytes);
+            if (uncompress(target.data(), &inflated, data, static_cast<uLong>(size)) != Z_OK) {
+                return false;
+            }
+            size = inflated;
+        } else {
+            // A stored chunk larger than the dataset's chunk is corrupt
+            if (size > chunk_bytes) {
+                return false;
+            }
+            // Shuffle stores byte j of every element together; bytes past the
+            // last whole element are kept as they are
+            size_t elements = size / raw.element_size;
+            for (size_t b = 0; b < raw.element_size; ++b) {
+                const uint8_t* plane = data + b * elements;
+                uint8_t* dst = target.data() + b;
+                for (size_t e = 0; e < elements; ++e) {
+                    dst[e * raw.element_size] = plane[e];
+                }
+            }
+            size_t whole = elements * raw.element_size;
+            std::memcpy(target.data() + whole, data + whole, size - whole);
+        }
+
+        data = target.data();
+        next ^= 1;
+    }
+
+    size_t length = raw.chunkLength(index) * raw.element_size;
+    if (size < length) {
+        return false;
+    }
+    std::memcpy(out, data, length);
+    return true;
+}
+
+bool H5ChunkReader::decode(const RawChunkedDataset& raw, void* out) {
+    uint8_t* base = static_cast<uint8_t*>(out);
+    for (size_t i = 0; i < raw.chunks.size(); ++i) {
+        if (!decodeChunk(raw, i, base + raw.chunkOffset(i) * raw.element_size)) {
+            return false;
+        }
+    }
     return true;
 }
 
+// ========== Memory-mapped Reading ==========
+
+std::shared_ptr<const MappedH5File> MappedH5File::open(const std::string& filepath) {
+    int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps its own reference to the file
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    return std::shared_ptr<const MappedH5File>(new MappedH5File(static_cast<const uint8_t*>(data), size));
+}
+
+MappedH5File::~MappedH5File() {
+    munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+const uint8_t* ContiguousExtent::bytes(const MappedH5File& mapping, size_t first, size_t count) const {
+    if (first > sample_count || count > sample_count - first) {
+        return nullptr;
+    }
+    uint64_t begin = offset + static_cast<uint64_t>(first) * element_size;
+    uint64_t length = static_cast<uint64_t>(count) * element_size;
+    if (begin > mapping.size() || length > mapping.size() - begin) {
+        return nullptr;
+    }
+    return mapping.data() + begin;
+}
+
+bool H5ContiguousReader::locate(const H5::DataSet& dataset, ContiguousExtent& extent) {
+    extent = ContiguousExtent();
+
+    H5::DSetCreatPropList plist = dataset.getCreatePlist();
+    if (plist.getLayout() != H5D_CONTIGUOUS || plist.getExternalCount() > 0) {
+        return false;
+    }
+
+    H5::DataSpace space = dataset.getSpace();
+    if (space.getSimpleExtentNdims() != 1) {
+        return false;
+    }
+    hsize_t dims[1];
+    space.getSimpleExtentDims(dims);
+
+    H5NumericReader::Storage storage = H5NumericReader::classify(dataset);
+    if (storage == H5NumericReader::Storage::Unsupported) {
+        return false;
+    }
+    H5::DataType file_type = dataset.getDataType();
+    if (!(file_type == H5NumericReader::memoryType(storage))) {
+        return false;
+    }
+
+    // HADDR_UNDEF until the first write allocates the storage
+    haddr_t offset = H5Dget_offset(dataset.getId());
+    size_t element_size = file_type.getSize();
+    if (offset == HADDR_UNDEF || dataset.getStorageSize() < dims[0] * element_size) {
+        return false;
+    }
+
+    extent.storage = storage;
+    extent.offset = offset;
+    extent.element_size = element_size;
+    extent.sample_count = dims[0];
+    return true;
+}
+
+bool H5ContiguousReader::copy(const ContiguousExtent& extent, const MappedH5File& mapping,
+                              size_t first, size_t count, double* out) {
+    const uint8_t* bytes = extent.bytes(mapping, first, count);
+    if (!bytes) {
+        return false;
+    }
+
+    // The file gives no alignment guarantee, so narrow samples go through
+    // an aligned per-thread copy before they are widened
+    thread_local std::vector<uint8_t> scratch;
+    auto staged = [&](auto tag) {
+        using T = decltype(tag);
+        scratch.resize(count * sizeof(T));
+        std::memcpy(scratch.data(), bytes, count * sizeof(T));
+        return reinterpret_cast<const T*>(scratch.data());
+    };
+
+    switch (extent.storage) {
+        case H5NumericReader::Storage::Float64:
+            std::memcpy(out, bytes, count * sizeof(double));
+            return true;
+        case H5NumericReader::Storage::Float32:
+            H5NumericReader::widen(staged(float()), out, count);
+            return true;
+        case H5NumericReader::Storage::Int32:
+            H5NumericReader::widen(staged(int32_t()), out, count);
+            return true;
+        case H5NumericReader::Storage::Int64: {
+            const int64_t* samples = staged(int64_t());
+            std::copy(samples, samples + count, out);
+            return true;
+        }
+        case H5NumericReader::Storage::UInt32: {
+            const uint32_t* samples = staged(uint32_t());
+            std::copy(samples, samples + count, out);
+            return true;
+        }
+        case H5NumericReader::Storage::UInt64: {
+            const uint64_t* samples = staged(uint64_t());
+            std::copy(samples, samples + count, out);
+            return true;
+        }
+        case H5NumericReader::Storage::Unsupported:
+            break;
+    }
+    return false;
+}
+
+bool H5ContiguousReader::copyNative(const ContiguousExtent& extent, const MappedH5File& mapping,
+                                    size_t first, size_t count, SignalColumn& column) {
+    const uint8_t* bytes = extent.bytes(mapping, first, count);
+    if (!bytes || extent.storage == H5NumericReader::Storage::Unsupported) {
+        return false;
+    }
+    size_t index = static_cast<size_t>(extent.storage);
+    if (column.index() != index) {
+        emplaceColumn(column, index);
+    }
+    std::visit([&](auto& native) {
+        native.resize(count);
+        std::memcpy(native.data(), bytes, count * extent.element_size);
+    }, column);
+    return true;
+}
+
+// ========== Chunked Signal Reading ==========
+
+SignalChunkReader::SignalChunkReader(const std::string& filepath,
+                                     const std::string& signal_name,
+                                     size_t chunk_samples)
+    : signal_name_(signal_name), chunk_samples_(std::max<size_t>(1, chunk_samples)) {
+    try {
+        H5::Exception::dontPrint();
+        file_.openFile(filepath, H5F_ACC_RDONLY);
+
+        if (!file_.nameExists("secondsPastEpoch")) {
+            last_error_ = "No secondsPastEpoch dataset found";
+            return;
+        }
+        seconds_ds_ = file_.openDataSet("secondsPastEpoch");
+        hsize_t timestamp_count = 0;
+        seconds_ds_.getSpace().getSimpleExtentDims(&timestamp_count);
+
+        if (file_.nameExists("nanoseconds")) {
+            nanos_ds_ = file_.openDataSet("nanoseconds");
+            hsize_t nanos_count = 0;
+            nanos_ds_.getSpace().getSimpleExtentDims(&nanos_count);
+            if (nanos_count != timestamp_count) {
+                last_error_ = "Timestamp array size mismatch";
+                return;
+            }
+            has_nanos_ = true;
+        }
+
+        dataset_ = file_.openDataSet(signal_name);
+        H5::DataSpace dataspace = dataset_.getSpace();
+        if (dataspace.getSimpleExtentNdims() < 1 || dataspace.getSimpleExtentNdims() > 3) {
+            last_error_ = "Signal dataset must be 1D-3D";
+            return;
+        }
+        ndims_ = dataspace.getSimpleExtentDims(dims_);
+
+        storage_ = H5NumericReader::classify(dataset_);
+        if (storage_ == H5NumericReader::Storage::Unsupported) {
+            last_error_ = "Signal dataset is not numeric";
+            return;
+        }
+
+        time_dim_index_ = findTimeDimension(dims_, ndims_, timestamp_count);
+
+        // Windows carry timestamps, so stop where either array runs out
+        total_samples_ = std::min<size_t>(dims_[time_dim_index_], timestamp_count);
+        open_ = true;
+
+    } catch (const H5::Exception& e) {
+        last_error_ = "HDF5 error opening signal: " + std::string(e.getDetailMsg());
+    }
+}
+
+SignalChunkReader::~SignalChunkReader() = default;
+
+void SignalChunkReader::seek(size_t sample) {
+    position_ = std::min(sample, total_samples_);
+}
+
+bool SignalChunkReader::next(SignalChunk& chunk) {
+    if (!open_ || position_ >= total_samples_) {
+        return false;
+    }
+
+    size_t count = std::min(chunk_samples_, total_samples_ - position_);
+    if (!readWindow(position_, count, chunk)) {
+        return false;
+    }
+
+    position_ += count;
+    return true;
+}
+
+bool SignalChunkReader::readWindow(size_t offset, size_t count, SignalChunk& chunk) {
+    try {
+        chunk.offset = offset;
+        chunk.values.resize(count);
+        chunk.seconds.resize(count);
+        chunk.nanoseconds.resize(count);
+
+        hsize_t mem_dims[1] = {count};
+        H5::DataSpace memspace(1, mem_dims);
+
+        // Signal window: `count` samples along time, index 0 on the other axes
+        hsize_t offsets[3] = {0, 0, 0};
+        hsize_t counts[3] = {1, 1, 1};
+        offsets[time_dim_index_] = offset;
+        counts[time_dim_index_] = count;
+
+        H5::DataSpace dataspace = dataset_.getSpace();
+        dataspace.selectHyperslab(H5S_SELECT_SET, counts, offsets);
+
+        if (!H5NumericReader::read(dataset_, storage_, chunk.values.data(), count,
+                                   memspace, dataspace)) {
+            last_error_ = "Signal dataset is not numeric";
+            return false;
+        }
+
+        // Same window of the timestamps
+        hsize_t ts_offset[1] = {offset};
+        hsize_t ts_count[1] = {count};
+
+        H5::DataSpace seconds_space = seconds_ds_.getSpace();
+        seconds_space.selectHyperslab(H5S_SELECT_SET, ts_count, ts_offset);
+        seconds_ds_.read(chunk.seconds.data(), H5::PredType::NATIVE_UINT64, memspace, seconds_space);
+
+        if (has_nanos_) {
+            H5::DataSpace nanos_space = nanos_ds_.getSpace();
+            nanos_space.selectHyperslab(H5S_SELECT_SET, ts_count, ts_offset);
+            nanos_ds_.read(chunk.nanoseconds.data(), H5::PredType::NATIVE_UINT64, memspace, nanos_space);
+        } else {
+            std::fill(chunk.nanoseconds.begin(), chunk.nanoseconds.end(), 0);
+        }
+
+        return true;
+
+    } catch (const H5::Exception& e) {
+        last_error_ = "HDF5 error reading signal window: " + std::string(e.getDetailMsg());
+        return false;
+    }
+}
+
+// ========== Multi-process Reading ==========
+
+namespace {
+
+constexpr uint32_t STOP_READER = UINT32_MAX;
+constexpr size_t JOBS_PER_READER = 2;  // Keep the next file queued while one is parsed
+
+// Parent -> reader
+struct ReaderJob {
+    uint32_t file_index;
+};
+
+// Reader -> parent; a memfd with `payload_bytes` of encoded results rides
+// along as SCM_RIGHTS ancillary data when payload_bytes > 0
+struct ReaderResult {
+    uint32_t file_index;
+    uint32_t parsed_ok;
+    uint64_t payload_bytes;
+};
+
+// Flat encoding of parse results. Both processes run the same binary, so
+// native byte order and layout are fine. Counting and writing share one code
+// path: SizeSink measures, BufferSink writes into the mapped memfd.
+struct SizeSink {
+    size_t bytes = 0;
+    void put(const void*, size_t n) { bytes += n; }
+};
+
+struct BufferSink {
+    char* out;
+    void put(const void* data, size_t n) {
+        std::memcpy(out, data, n);
+        out += n;
+    }
+};
+
+class PayloadReader {
+public:
+    PayloadReader(const char* data, size_t size) : p_(data), end_(data + size) {}
+
+    void get(void* out, size_t n) {
+        if (static_cast<size_t>(end_ - p_) < n) {
+            throw std::runtime_error("Truncated reader payload");
+        }
+        std::memcpy(out, p_, n);
+        p_ += n;
+    }
+
+    template<typename T>
+    T pod() {
+        T value;
+        get(&value, sizeof(value));
+        return value;
+    }
+
+    std::string str() {
+        std::string value(pod<uint64_t>(), '\0');
+        get(&value[0], value.size());
+        return value;
+    }
+
+    template<typename T>
+    void vec(std::vector<T>& out) {
+        out.resize(pod<uint64_t>());
+        get(out.data(), out.size() * sizeof(T));
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+template<typename Sink, typename T>
+void putPod(Sink& sink, const T& value) {
+    sink.put(&value, sizeof(value));
+}
+
+template<typename Sink>
+void putString(Sink& sink, const std::string& value) {
+    putPod<Sink, uint64_t>(sink, value.size());
+    sink.put(value.data(), value.size());
+}
+
+template<typename Sink, typename T>
+void putVector(Sink& sink, const std::vector<T>& values) {
+    putPod<Sink, uint64_t>(sink, values.size());
+    sink.put(values.data(), values.size() * sizeof(T));
+}
+
+// File state byte: the file never opened, opened without usable timestamps,
+// or opened with the timestamps that follow
+enum : uint8_t { FILE_NOT_OPENED = 0, FILE_NO_TIMESTAMPS = 1, FILE_WITH_TIMESTAMPS = 2 };
+
+template<typename Sink>
+void encodeResults(Sink& sink, bool file_opened, const TimestampData* timestamps,
+                   const std::vector<SignalData>& signals) {
+    uint8_t state = !file_opened ? FILE_NOT_OPENED
+                  : timestamps ? FILE_WITH_TIMESTAMPS : FILE_NO_TIMESTAMPS;
+    putPod(sink, state);
+    if (state == FILE_WITH_TIMESTAMPS) {
+        putVector(sink, timestamps->seconds);
+        putVector(sink, timestamps->nanoseconds);
+        putPod(sink, timestamps->period_nanos);
+        putPod<Sink, uint8_t>(sink, timestamps->is_regular_sampling);
+        putVector(sink, timestamps->runs);
+        putPod<Sink, uint64_t>(sink, timestamps->count);
+        putPod<Sink, uint64_t>(sink, timestamps->first_index);
+        putPod<Sink, uint64_t>(sink, timestamps->file_count);
+        putPod(sink, timestamps->start_time_sec);
+        putPod(sink, timestamps->start_time_nano);
+        putPod(sink, timestamps->end_time_sec);
+        putPod(sink, timestamps->end_time_nano);
+    }
+
+    putPod<Sink, uint64_t>(sink, signals.size());
+    for (const auto& signal : signals) {
+        const SignalInfo& info = signal.info;
+        for (const std::string* field : {&info.device, &info.device_area, &info.device_location,
+                                         &info.device_attribute, &info.full_name, &info.label,
+                                         &info.matlab_class, &info.units, &info.signal_type}) {
+            putString(sink, *field);
+        }
+        putVector(sink, signal.values);
+        putPod<Sink, uint8_t>(sink, static_cast<uint8_t>(signal.column.index()));
+        std::visit([&](const auto& native) { putVector(sink, native); }, signal.column);
+
+        const H5FileMetadata& meta = signal.file_metadata;
+        for (const std::string* field : {&meta.origin, &meta.pathway, &meta.date, &meta.time,
+                                         &meta.project, &meta.full_path}) {
+            putString(sink, *field);
+        }
+        putPod(sink, meta.file_timestamp_seconds);
+        putPod<Sink, uint8_t>(sink, meta.valid_timestamp);
+        putPod<Sink, uint8_t>(sink, signal.spatial_enrichment_ready);
+        putPod(sink, signal.quality);
+    }
+}
+
+std::shared_ptr<TimestampData> decodeResults(PayloadReader& in, bool& file_opened,
+                                             std::vector<SignalData>& signals) {
+    std::shared_ptr<TimestampData> timestamps;
+    uint8_t state = in.pod<uint8_t>();
+    file_opened = state != FILE_NOT_OPENED;
+    if (state == FILE_WITH_TIMESTAMPS) {
+        timestamps = std::make_shared<TimestampData>();
+        in.vec(timestamps->seconds);
+        in.vec(timestamps->nanoseconds);
+        timestamps->period_nanos = in.pod<uint64_t>();
+        timestamps->is_regular_sampling = in.pod<uint8_t>() != 0;
+        in.vec(timestamps->runs);
+        timestamps->count = in.pod<uint64_t>();
+        timestamps->first_index = in.pod<uint64_t>();
+        timestamps->file_count = in.pod<uint64_t>();
+        timestamps->start_time_sec = in.pod<uint64_t>();
+        timestamps->start_time_nano = in.pod<uint64_t>();
+        timestamps->end_time_sec = in.pod<uint64_t>();
+        timestamps->end_time_nano = in.pod<uint64_t>();
+    }
+
+    size_t count = in.pod<uint64_t>();
+    signals.resize(count);
+    for (auto& signal : signals) {
+        SignalInfo& info = signal.info;
+        for (std::string* field : {&info.device, &info.device_area, &info.device_location,
+                                   &info.device_attribute, &info.full_name, &info.label,
+                                   &info.matlab_class, &info.units, &info.signal_type}) {
+            *field = in.str();
+        }
+        in.vec(signal.values);
+        emplaceColumn(signal.column, in.pod<uint8_t>());
+        std::visit([&](auto& native) { in.vec(native); }, signal.column);
+
+        H5FileMetadata& meta = signal.file_metadata;
+        for (std::string* field : {&meta.origin, &meta.pathway, &meta.date, &meta.time,
+                                   &meta.project, &meta.full_path}) {
+            *field = in.str();
+        }
+        meta.file_timestamp_seconds = in.pod<uint64_t>();
+        meta.valid_timestamp = in.pod<uint8_t>() != 0;
+        signal.spatial_enrichment_ready = in.pod<uint8_t>() != 0;
+        signal.quality = in.pod<SampleStats>();
+        signal.timestamps = timestamps;
+    }
+    return timestamps;
+}
+
+bool sendResult(int sock, const ReaderResult& result, int memfd) {
+    struct iovec iov = {const_cast<ReaderResult*>(&result), sizeof(result)};
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    if (memfd >= 0) {
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &memfd, sizeof(int));
+    }
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    return sent == static_cast<ssize_t>(sizeof(result));
+}
+
+// Returns false on EOF or error; *memfd is -1 when no descriptor came along
+bool receiveResult(int sock, ReaderResult& result, int* memfd) {
+    struct iovec iov = {&result, sizeof(result)};
+    struct msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+        received = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+
+    *memfd = -1;
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            std::memcpy(memfd, CMSG_DATA(cmsg), sizeof(int));
+        }
+    }
+    return received == static_cast<ssize_t>(sizeof(result));
+}
+
+} // namespace
+
+size_t H5Parser::parseFilesInReaderProcesses(const std::vector<std::string>& files,
+                                             SignalVisitor& visitor) {
+    struct Reader {
+        pid_t pid = -1;
+        int sock = -1;
+        std::vector<uint32_t> assigned;  // Files sent but not yet answered
+    };
+
+    const size_t reader_count = std::min(parallel_readers_, files.size());
+    std::vector<Reader> readers(reader_count);
+
+    for (size_t r = 0; r < reader_count; ++r) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) != 0) {
+            break;
+        }
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            break;
+        }
+
+        if (pid == 0) {
+            // Reader process: a private copy of this parser and of HDF5
+            close(fds[0]);
+            for (size_t other = 0; other < r; ++other) {
+                close(readers[other].sock);
+            }
+            parsed_signals_.clear();
+            file_timestamps_.clear();
+            rebuildIndexes();
+
+            int sock = fds[1];
+            ReaderJob job;
+            while (recv(sock, &job, sizeof(job), 0) == static_cast<ssize_t>(sizeof(job)) &&
+                   job.file_index != STOP_READER && job.file_index < files.size()) {
+                const std::string& filepath = files[job.file_index];
+                ReaderResult result{job.file_index, 0, 0};
+                int memfd = -1;
+
+                try {
+                    result.parsed_ok = parseFile(filepath) ? 1 : 0;
+
+                    auto ts_it = file_timestamps_.find(filepath);
+                    bool file_opened = ts_it != file_timestamps_.end();
+                    const TimestampData* timestamps =
+                        ts_it != file_timestamps_.end() ? ts_it->second.get() : nullptr;
+
+                    SizeSink size_sink;
+                    encodeResults(size_sink, file_opened, timestamps, parsed_signals_);
+                    result.payload_bytes = size_sink.bytes;
+
+                    memfd = memfd_create("h5_reader_results", MFD_CLOEXEC);
+                    if (memfd < 0 || ftruncate(memfd, result.payload_bytes) != 0) {
+                        throw std::runtime_error("memfd setup failed");
+                    }
+                    void* mapped = mmap(nullptr, result.payload_bytes, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED, memfd, 0);
+                    if (mapped == MAP_FAILED) {
+                        throw std::runtime_error("memfd mmap failed");
+                    }
+                    BufferSink buffer_sink{static_cast<char*>(mapped)};
+                    encodeResults(buffer_sink, file_opened, timestamps, parsed_signals_);
+                    munmap(mapped, result.payload_bytes);
+                } catch (...) {
+                    result.parsed_ok = 0;
+                    result.payload_bytes = 0;
+                    if (memfd >= 0) {
+                        close(memfd);
+                        memfd = -1;
+                    }
+                }
+
+                parsed_signals_.clear();
+                file_timestamps_.clear();
+                rebuildIndexes();
+
+                bool sent = sendResult(sock, result, memfd);
+                if (memfd >= 0) {
+                    close(memfd);
+                }
+                if (!sent) {
+                    break;
+                }
+            }
+            _exit(0);
+        }
+
+        close(fds[1]);
+        readers[r].pid = pid;
+        readers[r].sock = fds[0];
+    }
+
+    // Drop readers that never started
+    readers.erase(std::remove_if(readers.begin(), readers.end(),
+                                 [](const Reader& reader) { return reader.pid < 0; }),
+                  readers.end());
+    if (readers.empty()) {
+        size_t valid_files = 0;
+        for (const auto& filepath : files) {
+            if (parseFile(filepath, visitor)) {
+                valid_files++;
+            }
+        }
+        return valid_files;
+    }
+
+    // Results are held until every earlier file is in, so signals are
+    // appended in the same order a sequential parse would produce
+    struct FileResult {
+        bool done = false;
+        bool ok = false;
+        bool opened = false;
+        std::shared_ptr<TimestampData> timestamps;
+        std::vector<SignalData> signals;
+    };
+    std::vector<FileResult> results(files.size());
+    std::vector<uint32_t> retry;  // Files orphaned by a reader that died
+    size_t next_job = 0;
+    size_t next_merge = 0;
+    size_t valid_files = 0;
+
+    auto dispatch = [&](Reader& reader) {
+        while (reader.sock >= 0 && reader.assigned.size() < JOBS_PER_READER &&
+               (!retry.empty() || next_job < files.size())) {
+            uint32_t index;
+            if (!retry.empty()) {
+                index = retry.back();
+                retry.pop_back();
+            } else {
+                index = static_cast<uint32_t>(next_job++);
+            }
+
+            ReaderJob job{index};
+            if (send(reader.sock, &job, sizeof(job), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(job))) {
+                retry.push_back(index);
+                return;
+            }
+            reader.assigned.push_back(index);
+        }
+    };
+
+    auto mergeReady = [&]() {
+        while (next_merge < files.size() && results[next_merge].done) {
+            FileResult& result = results[next_merge];
+            if (result.opened) {
+                H5FileMetadata file_metadata = parseFilename(files[next_merge]);
+                size_t signal_count = result.signals.size();
+                visitor.onFileStart(file_metadata, result.timestamps);
+                for (auto& signal : result.signals) {
+                    visitor.onSignal(std::move(signal));
+                }
+                visitor.onFileEnd(file_metadata, signal_count);
+            }
+            result.timestamps.reset();
+            result.signals = std::vector<SignalData>();
+            if (result.ok) {
+                valid_files++;
+            }
+            next_merge++;
+        }
+    };
+
+    for (auto& reader : readers) {
+        dispatch(reader);
+    }
+
+    size_t live_readers = readers.size();
+    while (live_readers > 0 && next_merge < files.size()) {
+        std::vector<struct pollfd> pollfds;
+        std::vector<Reader*> polled;
+        for (auto& reader : readers) {
+            if (reader.sock >= 0) {
+                pollfds.push_back({reader.sock, POLLIN, 0});
+                polled.push_back(&reader);
+            }
+        }
+
+        if (poll(pollfds.data(), pollfds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (size_t i = 0; i < pollfds.size(); ++i) {
+            if (pollfds[i].revents == 0) continue;
+            Reader& reader = *polled[i];
+
+            ReaderResult header;
+            int memfd = -1;
+            if (!receiveResult(reader.sock, header, &memfd) || header.file_index >= files.size()) {
+                // Reader died: hand its files to the others
+                if (memfd >= 0) close(memfd);
+                close(reader.sock);
+                reader.sock = -1;
+                retry.insert(retry.end(), reader.assigned.begin(), reader.assigned.end());
+                reader.assigned.clear();
+                live_readers--;
+                continue;
+            }
+
+            reader.assigned.erase(std::remove(reader.assigned.begin(), reader.assigned.end(),
+                                              header.file_index),
+                                  reader.assigned.end());
+
+            FileResult& result = results[header.file_index];
+            result.done = true;
+            result.ok = header.parsed_ok != 0;
+            if (memfd >= 0 && header.payload_bytes > 0) {
+                void* mapped = mmap(nullptr, header.payload_bytes, PROT_READ, MAP_PRIVATE, memfd, 0);
+                if (mapped != MAP_FAILED) {
+                    try {
+                        PayloadReader in(static_cast<const char*>(mapped), header.payload_bytes);
+                        result.timestamps = decodeResults(in, result.opened, result.signals);
+                    } catch (const std::exception&) {
+                        result.ok = false;
+                        result.signals.clear();
+                    }
+                    munmap(mapped, header.payload_bytes);
+                } else {
+                    result.ok = false;
+                }
+            }
+            if (memfd >= 0) close(memfd);
+        }
+
+        for (auto& reader : readers) {
+            dispatch(reader);
+        }
+        mergeReady();
+    }
+
+    for (auto& reader : readers) {
+        if (reader.sock >= 0) {
+            ReaderJob stop{STOP_READER};
+            send(reader.sock, &stop, sizeof(stop), MSG_NOSIGNAL);
+            close(reader.sock);
+        }
+        int status;
+        while (waitpid(reader.pid, &status, 0) < 0 && errno == EINTR) {
+        }
+    }
+
+    // If every reader died, finish the remaining files in this process
+    while (next_merge < files.size()) {
+        if (!results[next_merge].done) {
+            if (parseFile(files[next_merge], visitor)) {
+                valid_files++;
+            }
+            next_merge++;
+        }
+        mergeReady();
+    }
+
+    return valid_files;
+}
+
 // Getter methods
 std::vector<SignalData> H5Parser::getAllSignals() const {
     return parsed_signals_;
@@ -566,60 +1838,95 @@ std::vector<SignalData> H5Parser::getAllSignals() const {
 
 std::vector<SignalData> H5Parser::getSignalsByDevice(const std::string& device) const {
     std::vector<SignalData> filtered;
-    for (const auto& signal : parsed_signals_) {
-        if (signal.info.device == device) {
-            filtered.push_back(signal);
-        }
+    for (const SignalData* signal : findSignalsByDevice(device)) {
+        filtered.push_back(*signal);
     }
     return filtered;
 }
 
 std::vector<SignalData> H5Parser::getSignalsByDeviceArea(const std::string& device_area) const {
     std::vector<SignalData> filtered;
-    for (const auto& signal : parsed_signals_) {
-        if (signal.info.device_area == device_area) {
-            filtered.push_back(signal);
-        }
+    for (const SignalData* signal : findSignalsByDeviceArea(device_area)) {
+        filtered.push_back(*signal);
     }
     return filtered;
 }
 
 std::vector<SignalData> H5Parser::getSignalsByDeviceAttribute(const std::string& device_attribute) const {
     std::vector<SignalData> filtered;
-    for (const auto& signal : parsed_signals_) {
-        if (signal.info.device_attribute == device_attribute) {
-            filtered.push_back(signal);
-        }
+    for (const SignalData* signal : findSignalsByDeviceAttribute(device_attribute)) {
+        filtered.push_back(*signal);
     }
     return filtered;
 }
 
 std::vector<SignalData> H5Parser::getSignalsByProject(const std::string& project) const {
     std::vector<SignalData> filtered;
-    for (const auto& signal : parsed_signals_) {
-        if (signal.file_metadata.project == project) {
-            filtered.push_back(signal);
-        }
+    for (const SignalData* signal : findSignalsByProject(project)) {
+        filtered.push_back(*signal);
     }
     return filtered;
 }
 
+// Indexed lookups
+H5Parser::SignalRefs H5Parser::findSignalsByDevice(const std::string& device) const {
+    return lookup(device_index_, device);
+}
+
+H5Parser::SignalRefs H5Parser::findSignalsByDeviceArea(const std::string& device_area) const {
+    return lookup(device_area_index_, device_area);
+}
+
+H5Parser::SignalRefs H5Parser::findSignalsByDeviceAttribute(const std::string& device_attribute) const {
+    return lookup(device_attribute_index_, device_attribute);
+}
+
+H5Parser::SignalRefs H5Parser::findSignalsByProject(const std::string& project) const {
+    return lookup(project_index_, project);
+}
+
 SignalData* H5Parser::findSignal(const std::string& signal_name) {
-    for (auto& signal : parsed_signals_) {
-        if (signal.info.full_name == signal_name) {
-            return &signal;
-        }
-    }
-    return nullptr;
+    auto it = name_index_.find(signal_name);
+    return it != name_index_.end() ? &parsed_signals_[it->second] : nullptr;
 }
 
 const SignalData* H5Parser::findSignal(const std::string& signal_name) const {
-    for (const auto& signal : parsed_signals_) {
-        if (signal.info.full_name == signal_name) {
-            return &signal;
+    auto it = name_index_.find(signal_name);
+    return it != name_index_.end() ? &parsed_signals_[it->second] : nullptr;
+}
+
+H5Parser::SignalRefs H5Parser::lookup(
+    const std::unordered_map<std::string, std::vector<size_t>>& index,
+    const std::string& key) const {
+    SignalRefs refs;
+    auto it = index.find(key);
+    if (it != index.end()) {
+        refs.reserve(it->second.size());
+        for (size_t position : it->second) {
+            refs.push_back(&parsed_signals_[position]);
         }
     }
-    return nullptr;
+    return refs;
+}
+
+void H5Parser::indexSignal(size_t position) {
+    const SignalData& signal = parsed_signals_[position];
+    name_index_.emplace(signal.info.full_name, position);  // First one wins, as with a scan
+    device_index_[signal.info.device].push_back(position);
+    device_area_index_[signal.info.device_area].push_back(position);
+    device_attribute_index_[signal.info.device_attribute].push_back(position);
+    project_index_[signal.file_metadata.project].push_back(position);
+}
+
+void H5Parser::rebuildIndexes() {
+    name_index_.clear();
+    device_index_.clear();
+    device_area_index_.clear();
+    device_attribute_index_.clear();
+    project_index_.clear();
+    for (size_t i = 0; i < parsed_signals_.size(); ++i) {
+        indexSignal(i);
+    }
 }
 
 std::vector<H5FileMetadata> H5Parser::getFileMetadata() const {